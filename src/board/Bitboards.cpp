@@ -0,0 +1,203 @@
+#include "Bitboards.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Bitboards definitions, builds the sliding attack tables at startup
+
+namespace Bitboards {
+	Magic rookMagics[SQUARES];
+	Magic bishopMagics[SQUARES];
+	bool usePext = false;
+	Bitboard knightTable[SQUARES];
+	Bitboard kingTable[SQUARES];
+	Bitboard pawnTable[2][SQUARES];
+	Bitboard betweenTable[SQUARES][SQUARES];
+	Bitboard lineTable[SQUARES][SQUARES];
+
+	// attack tables sliced up between the squares
+	Bitboard rookTable[0x19000];
+	Bitboard bishopTable[0x1480];
+
+	/**
+	 * method to pack the bits of a set selected by a mask into the low bits,
+	 * compiled for BMI2 on its own so that the rest of the program still runs
+	 * on CPUs without it
+	 * @param b - the set to take bits from
+	 * @param mask - the bits to take
+	 * @return - the packed bits
+	 */
+#if defined(__x86_64__) || defined(__i386__)
+	__attribute__((target("bmi2")))
+	unsigned int pext(Bitboard b, Bitboard mask) {
+		return _pext_u64(b, mask);
+	}
+#else
+	unsigned int pext(Bitboard b, Bitboard mask) {
+		unsigned int packed = 0, i = 0;
+		for (; mask; mask &= mask - 1, i++) {
+			if (b & (mask & (0 - mask))) { packed |= 1u << i; }
+		}
+		return packed;
+	}
+#endif
+
+	/**
+	 * method to walk a slider's rays one tile at a time, used only to fill the
+	 * tables
+	 * @param s - the square index of the slider
+	 * @param occ - the occupied tiles
+	 * @param diagonal - true for bishop rays, false for rook rays
+	 * @return - the attacked tiles
+	 */
+	Bitboard slowAttacks(unsigned int s, Bitboard occ, bool diagonal) {
+		const int rook[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+		const int bishop[4][2] = {{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+		Bitboard attacks = 0;
+		for (unsigned int j = 0; j < 4; j++) {
+			int dx = (diagonal) ? bishop[j][0] : rook[j][0];
+			int dy = (diagonal) ? bishop[j][1] : rook[j][1];
+			int x = (s % COLS) + dx, y = (s / COLS) + dy;
+			for (; x >= 0 && x < (int)COLS && y >= 0 && y < (int)ROWS;
+					x += dx, y += dy) {
+				attacks |= square(x, y);
+				if (occ & square(x, y)) { break; } // cannot go over pieces
+			}
+		}
+		return attacks;
+	}
+
+	/**
+	 * method to find the tiles whose occupancy matters to a slider, its rays
+	 * without the edge tiles at their ends
+	 * @param s - the square index of the slider
+	 * @param diagonal - true for bishop rays, false for rook rays
+	 * @return - the mask
+	 */
+	Bitboard relevantMask(unsigned int s, bool diagonal) {
+		const Bitboard fileA = 0x0101010101010101ULL, row1 = 0xFFULL;
+		Bitboard edges = ((row1 | (row1 << 56)) & ~(row1 << (s / COLS * 8)));
+		edges |= ((fileA | (fileA << 7)) & ~(fileA << (s % COLS)));
+		return slowAttacks(s, 0, diagonal) & ~edges;
+	}
+
+	/**
+	 * method to build one slider's lookups, for each square either indexing by
+	 * PEXT or searching for a magic number which indexes every occupancy of
+	 * the mask without two needing different attacks in the same entry
+	 * @param magics - the lookups to fill
+	 * @param table - the attack table to slice up
+	 * @param diagonal - true for bishops, false for rooks
+	 */
+	void initSlider(Magic* magics, Bitboard* table, bool diagonal) {
+		// fixed seeds per row, known to find magics quickly
+		const uint64_t seeds[ROWS] = {
+			728, 10316, 55013, 32803, 12281, 15100, 16645, 255
+		};
+		uint64_t seed = 0;
+		Bitboard occupancy[4096], reference[4096];
+		unsigned int epoch[4096] = {0}, attempt = 0;
+		Bitboard* slice = table;
+		for (unsigned int s = 0; s < SQUARES; s++) {
+			Magic &m = magics[s];
+			m.mask = relevantMask(s, diagonal);
+			m.shift = 64 - popCount(m.mask);
+			m.attacks = slice;
+			seed = seeds[s / COLS];
+			// enumerate every subset of the mask (carry-rippler)
+			unsigned int size = 0;
+			Bitboard b = 0;
+			do {
+				occupancy[size] = b;
+				reference[size] = slowAttacks(s, b, diagonal);
+				if (usePext) { slice[pext(b, m.mask)] = reference[size]; }
+				size++;
+				b = (b - m.mask) & m.mask;
+			} while (b);
+			slice += size;
+			if (usePext) { continue; }
+			// try sparse random multipliers until one works
+			for (unsigned int i = 0; i < size; ) {
+				m.magic = 0;
+				while (popCount((m.mask * m.magic) >> 56) < 6) {
+					Bitboard r = ~0ULL;
+					for (unsigned int k = 0; k < 3; k++) {
+						seed ^= seed >> 12; seed ^= seed << 25;
+						seed ^= seed >> 27;
+						r &= seed * 2685821657736338717ULL;
+					}
+					m.magic = r;
+				}
+				// a table entry written this attempt must agree to be shared
+				attempt++;
+				for (i = 0; i < size; i++) {
+					Bitboard idx = (occupancy[i] * m.magic) >> m.shift;
+					if (epoch[idx] < attempt) {
+						epoch[idx] = attempt;
+						m.attacks[idx] = reference[i];
+					} else if (m.attacks[idx] != reference[i]) {
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * method to find the tiles a list of single steps reaches from a square
+	 * @param s - the square index
+	 * @param steps - column and row offsets
+	 * @param n - the number of steps
+	 * @return - the tiles reached within the board
+	 */
+	Bitboard stepAttacks(unsigned int s, const int steps[][2], unsigned int n) {
+		Bitboard attacks = 0;
+		for (unsigned int j = 0; j < n; j++) {
+			int x = (s % COLS) + steps[j][0], y = (s / COLS) + steps[j][1];
+			if (x >= 0 && x < (int)COLS && y >= 0 && y < (int)ROWS) {
+				attacks |= square(x, y);
+			}
+		}
+		return attacks;
+	}
+
+	// the tables are built once before main() runs
+	struct Init {
+		Init() {
+			const int knight[8][2] = {
+				{1, 2}, {-1, 2}, {2, 1}, {2, -1},
+				{-2, 1}, {-2, -1}, {1, -2}, {-1, -2}
+			};
+			const int king[8][2] = {
+				{0, 1}, {1, 1}, {1, 0}, {1, -1},
+				{0, -1}, {-1, -1}, {-1, 0}, {-1, 1}
+			};
+			const int whitePawn[2][2] = {{1, 1}, {-1, 1}};
+			const int blackPawn[2][2] = {{1, -1}, {-1, -1}};
+			for (unsigned int s = 0; s < SQUARES; s++) {
+				knightTable[s] = stepAttacks(s, knight, 8);
+				kingTable[s] = stepAttacks(s, king, 8);
+				pawnTable[1][s] = stepAttacks(s, whitePawn, 2);
+				pawnTable[0][s] = stepAttacks(s, blackPawn, 2);
+			}
+#if defined(__x86_64__) || defined(__i386__)
+			usePext = __builtin_cpu_supports("bmi2");
+#endif
+			initSlider(rookMagics, rookTable, false);
+			initSlider(bishopMagics, bishopTable, true);
+			// squares in line see each other along an empty board's rays
+			for (unsigned int a = 0; a < SQUARES; a++) {
+				for (unsigned int b = 0; b < SQUARES; b++) {
+					for (unsigned int d = 0; d < 2; d++) {
+						Bitboard ray = slowAttacks(a, 0, d == 1);
+						if (a == b || !(ray & bit(b))) { continue; }
+						lineTable[a][b] = (ray & slowAttacks(b, 0, d == 1));
+						lineTable[a][b] |= bit(a) | bit(b);
+						betweenTable[a][b] = slowAttacks(a, bit(b), d == 1);
+						betweenTable[a][b] &= slowAttacks(b, bit(a), d == 1);
+					}
+				}
+			}
+		}
+	} init;
+}
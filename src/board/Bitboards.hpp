@@ -0,0 +1,200 @@
+#pragma once
+#include <stdint.h>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * bitboard helpers, a bitboard is a set of tiles packed into 64 bits where
+ * bit (r * 8) + c stands for the tile at column c and row r, so bit 0 is a1,
+ * bit 7 is h1 and bit 63 is h8
+ */
+
+typedef uint64_t Bitboard;
+
+namespace Bitboards {
+	const static unsigned int COLS = 8, ROWS = 8, SQUARES = 64;
+
+	/**
+	 * method to find the square index of a coordinate
+	 * @param c - the columnar coordinate
+	 * @param r - the row coordinate
+	 * @return - the square index
+	 */
+	inline unsigned int index(unsigned int c, unsigned int r) {
+		return (r * COLS) + c;
+	}
+
+	/**
+	 * method to find the set holding a single square
+	 * @param s - the square index
+	 * @return - a bitboard with only that square set
+	 */
+	inline Bitboard bit(unsigned int s) {
+		return 1ULL << s;
+	}
+
+	/**
+	 * method to find the set holding a single coordinate
+	 * @param c - the columnar coordinate
+	 * @param r - the row coordinate
+	 * @return - a bitboard with only that tile set
+	 */
+	inline Bitboard square(unsigned int c, unsigned int r) {
+		return bit(index(c, r));
+	}
+
+	/**
+	 * method to count the squares in a set
+	 * @param b - the set to count
+	 * @return - how many squares are set
+	 */
+	inline unsigned int popCount(Bitboard b) {
+		return __builtin_popcountll(b);
+	}
+
+	/**
+	 * method to find the lowest square in a set, undefined for an empty set
+	 * @param b - the set to look in
+	 * @return - the lowest square index
+	 */
+	inline unsigned int lsb(Bitboard b) {
+		return __builtin_ctzll(b);
+	}
+
+	/**
+	 * method to remove and return the lowest square in a set, iterating this
+	 * way visits tiles in the same a1, b1, ..., h8 order as a row scan
+	 * @param b - the set to pop from
+	 * @return - the square index removed
+	 */
+	inline unsigned int popLsb(Bitboard &b) {
+		unsigned int s = lsb(b);
+		b &= b - 1;
+		return s;
+	}
+
+	/**
+	 * sliding attack lookup for one square. The occupancy of the tiles a
+	 * slider's rays cross (short of the edge, which never block anything
+	 * beyond) is hashed into an index into that square's slice of the attack
+	 * table, either by multiplying by a "magic" number which maps every
+	 * occupancy without a harmful collision, or by the BMI2 PEXT instruction
+	 * which packs the occupancy bits together directly
+	 */
+	struct Magic {
+		Bitboard mask; // the tiles whose occupancy matters
+		Bitboard magic; // the multiplier, unused with PEXT
+		unsigned int shift; // 64 less the number of index bits
+		Bitboard* attacks; // this square's slice of the attack table
+	};
+	extern Magic rookMagics[SQUARES];
+	extern Magic bishopMagics[SQUARES];
+	extern bool usePext; // whether the CPU has BMI2, found at startup
+
+	// attacks of the non-sliding pieces from each square
+	extern Bitboard knightTable[SQUARES];
+	extern Bitboard kingTable[SQUARES];
+	extern Bitboard pawnTable[2][SQUARES]; // indexed by color, then square
+	// tiles strictly between two squares, and the whole line through both
+	extern Bitboard betweenTable[SQUARES][SQUARES];
+	extern Bitboard lineTable[SQUARES][SQUARES];
+
+	unsigned int pext(Bitboard, Bitboard);
+
+	/**
+	 * method to find a slider's attack table index
+	 * @param m - the lookup for the slider's square
+	 * @param occ - the occupied tiles
+	 * @return - the index into that square's slice of the table
+	 */
+	inline unsigned int magicIndex(const Magic &m, Bitboard occ) {
+#if defined(__BMI2__)
+		return _pext_u64(occ, m.mask);
+#else
+		if (usePext) { return pext(occ, m.mask); }
+		return ((occ & m.mask) * m.magic) >> m.shift;
+#endif
+	}
+
+	/**
+	 * method to find the tiles a rook attacks, including the first piece met
+	 * along each ray whatever its color
+	 * @param s - the square index of the rook
+	 * @param occ - the occupied tiles
+	 * @return - the attacked tiles
+	 */
+	inline Bitboard rookAttacks(unsigned int s, Bitboard occ) {
+		return rookMagics[s].attacks[magicIndex(rookMagics[s], occ)];
+	}
+
+	/**
+	 * method to find the tiles a bishop attacks, as rookAttacks
+	 * @param s - the square index of the bishop
+	 * @param occ - the occupied tiles
+	 * @return - the attacked tiles
+	 */
+	inline Bitboard bishopAttacks(unsigned int s, Bitboard occ) {
+		return bishopMagics[s].attacks[magicIndex(bishopMagics[s], occ)];
+	}
+
+	/**
+	 * method to find the tiles a queen attacks, as rookAttacks
+	 * @param s - the square index of the queen
+	 * @param occ - the occupied tiles
+	 * @return - the attacked tiles
+	 */
+	inline Bitboard queenAttacks(unsigned int s, Bitboard occ) {
+		return rookAttacks(s, occ) | bishopAttacks(s, occ);
+	}
+
+	/**
+	 * method to find the tiles a knight attacks
+	 * @param s - the square index of the knight
+	 * @return - the attacked tiles
+	 */
+	inline Bitboard knightAttacks(unsigned int s) {
+		return knightTable[s];
+	}
+
+	/**
+	 * method to find the tiles a king attacks
+	 * @param s - the square index of the king
+	 * @return - the attacked tiles
+	 */
+	inline Bitboard kingAttacks(unsigned int s) {
+		return kingTable[s];
+	}
+
+	/**
+	 * method to find the tiles a pawn attacks (diagonally forward)
+	 * @param c - the color of the pawn
+	 * @param s - the square index of the pawn
+	 * @return - the attacked tiles
+	 */
+	inline Bitboard pawnAttacks(bool c, unsigned int s) {
+		return pawnTable[c][s];
+	}
+
+	/**
+	 * method to find the tiles strictly between two squares sharing a row,
+	 * column or diagonal, a piece moving there blocks a slider's ray
+	 * @param a - the square index of one end
+	 * @param b - the square index of the other end
+	 * @return - the tiles between, empty if the squares are not in line
+	 */
+	inline Bitboard between(unsigned int a, unsigned int b) {
+		return betweenTable[a][b];
+	}
+
+	/**
+	 * method to find the whole row, column or diagonal through two squares,
+	 * edge to edge, a pinned piece may only move along it
+	 * @param a - the square index of one square
+	 * @param b - the square index of the other
+	 * @return - the tiles of the line, empty if the squares are not in line
+	 */
+	inline Bitboard line(unsigned int a, unsigned int b) {
+		return lineTable[a][b];
+	}
+}
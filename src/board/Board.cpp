@@ -6,7 +6,7 @@
  */
 
 // board constructor
-Board::Board() {
+Board::Board() : version(0), statusVersion(0), statusSide(WHITE) {
 	initNormalBoard();
 }
 
@@ -16,120 +16,356 @@ Board::Board() {
  * @param m - the move to make
  */
 void Board::movePiece(Move m) {
-	bool color = (*this)(m.getOrigC(), m.getOrigR()).getPiece().getColor();
-	Tile destMove = (*this)(m.getDestC(), m.getDestR());
-	if (destMove && destMove.getPiece().getColor() != color) {
-		/**
-		 * Tile::reset() is an explicit destructor as we want specific logic for
-		 * when a tile is destroyed but also to only be able to call it
-		 * explicitly rather than implicit default
-		 */
-		(*this)(m.getDestC(), m.getDestR()).reset();
-	}
-	// make a new copy of the origin tile and insert into destination tile
-	switch((*this)(m.getOrigC(), m.getOrigR()).getPiece().getType()) {
-		case 'P': case 'p': // if pawn
-			// promotion handler
-			if (m.getDestR() == COLS-1 && color == WHITE) {
-				// promote pawn to queen if reached top and white
-				(*this)(m.getDestC(), m.getDestR()) = new Queen(color);
-			} else if (m.getDestR() == 0 && color == BLACK) {
-				// promote pawn to queen if reached bottom and black
-				(*this)(m.getDestC(), m.getDestR()) = new Queen(color);
-			} else {
-				// else remain a pawn
-				(*this)(m.getDestC(), m.getDestR()) = new Pawn(color);
-			} break;
-		case 'N': case 'n': // if knight
-			(*this)(m.getDestC(), m.getDestR()) = new Knight(color); break;
-		case 'B': case 'b': // if bishop
-			(*this)(m.getDestC(), m.getDestR()) = new Bishop(color); break;
-		case 'R': case 'r': // if rook
-			(*this)(m.getDestC(), m.getDestR()) = new Rook(color); break;
-		case 'Q': case 'q': // if queen
-			(*this)(m.getDestC(), m.getDestR()) = new Queen(color); break;
-		case 'K': case 'k': // if king
-			// castling handler, short circuit in case tile is empty
-			char idealColor = ((color) ? 'R' : 'r');
-			if (destMove && destMove.getPiece().getType() == idealColor) {
-				// init new pieces in correct positions
-				(*this)(m.getDestC(), m.getDestR()) = new King(color);
-				(*this)(m.getOrigC(), m.getOrigR()) = new Rook(color);
-				// set those pieces as moved
-				(*this)(m.getDestC(), m.getDestR()).getPiece().setMoved(true);
-				(*this)(m.getOrigC(), m.getOrigR()).getPiece().setMoved(true);
-				// we do not need the destructor below, so exit method
-				return;
-			} else {
-				// otherwise it is a normal move
-				(*this)(m.getDestC(), m.getDestR()) = new King(color);
-			} break;
+	Undo u; // the game never takes moves back, so the record is dropped
+	makeMove(m, u);
+}
+
+/**
+ * method to make a move reversibly, search makes and unmakes every move on one
+ * board rather than moving on a fresh copy of the board per node
+ * @param m - the move to make
+ * @param u - the undo record to fill for unmakeMove
+ */
+void Board::makeMove(Move m, Undo &u) {
+	unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+	unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+	bool color = (colors[WHITE] & Bitboards::bit(orig)) != 0;
+	unsigned int type = getType(color, orig);
+	bool ontoRook = (pieces[color][Piece::ROOK] & Bitboards::bit(dest)) != 0;
+	u.moved = type;
+	u.captured = Piece::TYPES;
+	u.castling = castling;
+	u.key = key;
+	u.halfmoves = halfmoves;
+	u.promoted = false;
+	u.castled = (type == Piece::KING && ontoRook);
+	// castling handler, a king moving onto its own rook swaps the two
+	if (u.castled) {
+		removePiece(color, Piece::KING, orig);
+		removePiece(color, Piece::ROOK, dest);
+		putPiece(color, Piece::KING, dest);
+		putPiece(color, Piece::ROOK, orig);
+	} else {
+		// remove any captured piece from the destination
+		if (colors[!color] & Bitboards::bit(dest)) {
+			u.captured = getType(!color, dest);
+			removePiece(!color, u.captured, dest);
+		}
+		removePiece(color, type, orig);
+		// promotion handler, pawns reaching the far row become queens
+		if (type == Piece::PAWN && m.getDestR() == ((color) ? ROWS-1 : 0)) {
+			type = Piece::QUEEN;
+			u.promoted = true;
+		}
+		putPiece(color, type, dest);
 	}
-	// mark the piece as moved
-	(*this)(m.getDestC(), m.getDestR()).getPiece().setMoved(true);
-	// destroy the origin to complete the move
-	(*this)(m.getOrigC(), m.getOrigR()).reset();
+	// a king or rook leaving (or a rook being taken on) home loses castling
+	key ^= Zobrist::castling[castling];
+	castling &= castleMask(orig) & castleMask(dest);
+	key ^= Zobrist::castling[castling];
+	// the other side moves next
+	key ^= Zobrist::side;
+	keys[plies++ % KEY_HISTORY] = u.key;
+	// captures and pawn moves cannot be undone, so restart the clock
+	bool reversible = u.moved != Piece::PAWN && u.captured == Piece::TYPES;
+	halfmoves = (reversible) ? halfmoves + 1 : 0;
+	version++;
+}
+
+/**
+ * method to take back a move made with makeMove, moves must be unmade in the
+ * reverse order they were made
+ * @param m - the move to take back
+ * @param u - the undo record makeMove filled
+ */
+void Board::unmakeMove(Move m, const Undo &u) {
+	unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+	unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+	// the moving piece now stands on the destination
+	bool color = (colors[WHITE] & Bitboards::bit(dest)) != 0;
+	if (u.castled) {
+		removePiece(color, Piece::KING, dest);
+		removePiece(color, Piece::ROOK, orig);
+		putPiece(color, Piece::KING, orig);
+		putPiece(color, Piece::ROOK, dest);
+	} else {
+		removePiece(color, (u.promoted) ? Piece::QUEEN : u.moved, dest);
+		putPiece(color, u.moved, orig);
+		// restore any captured piece
+		if (u.captured != Piece::TYPES) {
+			putPiece(!color, u.captured, dest);
+		}
+	}
+	castling = u.castling;
+	key = u.key;
+	halfmoves = u.halfmoves;
+	plies--;
+	version++;
+}
+
+/**
+ * method to pass the move to the other player without moving, which is not a
+ * legal move but lets search ask how good a position is for the player to move
+ * @param u - the undo record to fill for unmakeNullMove
+ */
+void Board::makeNullMove(Undo &u) {
+	u.key = key;
+	u.halfmoves = halfmoves;
+	key ^= Zobrist::side;
+	keys[plies++ % KEY_HISTORY] = u.key;
+	// no repetition may reach back past a null move
+	halfmoves = 0;
+	version++;
+}
+
+/**
+ * method to take back a move made with makeNullMove
+ * @param u - the undo record makeNullMove filled
+ */
+void Board::unmakeNullMove(const Undo &u) {
+	key = u.key;
+	halfmoves = u.halfmoves;
+	plies--;
+	version++;
 }
 
 // method to create a standard positioned chess board
 void Board::initNormalBoard() {
-	// back row black
-	(*this)(A, 8-1) = new Rook(BLACK);
-	(*this)(B, 8-1) = new Knight(BLACK);
-	(*this)(C, 8-1) = new Bishop(BLACK);
-	(*this)(D, 8-1) = new Queen(BLACK);
-	(*this)(E, 8-1) = new King(BLACK);
-	(*this)(F, 8-1) = new Bishop(BLACK);
-	(*this)(G, 8-1) = new Knight(BLACK);
-	(*this)(H, 8-1) = new Rook(BLACK);
-	// front row black
+	castling = CASTLE_WHITE_EAST | CASTLE_WHITE_WEST;
+	castling |= CASTLE_BLACK_EAST | CASTLE_BLACK_WEST;
+	clearBoard();
+	// back row order from column A through H
+	const unsigned int backRow[COLS] = {
+		Piece::ROOK, Piece::KNIGHT, Piece::BISHOP, Piece::QUEEN,
+		Piece::KING, Piece::BISHOP, Piece::KNIGHT, Piece::ROOK
+	};
 	for (unsigned int i = 0; i < COLS; i++) {
-		(*this)(i, 7-1) = new Pawn(BLACK);
+		// back row and front row black
+		putPiece(BLACK, backRow[i], Bitboards::index(i, 8-1));
+		putPiece(BLACK, Piece::PAWN, Bitboards::index(i, 7-1));
+		// front row and back row white
+		putPiece(WHITE, Piece::PAWN, Bitboards::index(i, 2-1));
+		putPiece(WHITE, backRow[i], Bitboards::index(i, 1-1));
 	}
-	// front row white
-	for (unsigned int i = 0; i < COLS; i++) {
-		(*this)(i, 2-1) = new Pawn(WHITE);
-	}
-	// back row white
-	(*this)(A, 1-1) = new Rook(WHITE);
-	(*this)(B, 1-1) = new Knight(WHITE);
-	(*this)(C, 1-1) = new Bishop(WHITE);
-	(*this)(D, 1-1) = new Queen(WHITE);
-	(*this)(E, 1-1) = new King(WHITE);
-	(*this)(F, 1-1) = new Bishop(WHITE);
-	(*this)(G, 1-1) = new Knight(WHITE);
-	(*this)(H, 1-1) = new Rook(WHITE);
-}
-
-/**
- * method to determine if a player is in checkmate
- * @param c - the player to check
- * @return - whether that player is checkmated
- */
-bool Board::determineCheckmate(bool c) {
-	if (determineCheck(c)) {
-		/**
-		 * must go through every next-step board state to determine if a
-		 * checkmate has occurred. Find every move the proposed player can make
-		 * and see if any of those moves leaves check
-		 */
-		std::vector<Move> moveList = getAllMoves(!c);
-		// find all next-step board states
-		for (unsigned int i = 0; i < moveList.size(); i++) {
-			Board copy(*this);
-			copy.movePiece(moveList[i]);
-			// if successfully able to leave check
-			if (!copy.determineCheck(c)) { return false; }
-			/**
-			 * as copy is not a pointer, it has implicit destruction upon
-			 * leaving scope here. No destructor or handler is necessary, thus
-			 * no memory leak
-			 */
+}
+
+// method to take every piece off the board, keeping the castling rights
+void Board::clearBoard() {
+	for (unsigned int i = 0; i < Piece::TYPES; i++) {
+		pieces[WHITE][i] = 0; pieces[BLACK][i] = 0;
+	}
+	colors[WHITE] = 0; colors[BLACK] = 0; occupied = 0;
+	material[WHITE] = 0; material[BLACK] = 0;
+	pawnRanks[WHITE] = 0; pawnRanks[BLACK] = 0;
+	key = Zobrist::castling[castling]; // pieces are hashed in as placed
+	halfmoves = 0;
+	plies = 0;
+	version++;
+}
+
+/**
+ * method to set up the position described in Forsyth-Edwards Notation. The
+ * piece placement, side to move, castling and halfmove clock fields are read,
+ * the en passant square is ignored as en passant is not implemented. Castling
+ * rights are only kept while that king and rook are home, as move generation
+ * assumes
+ * @param fen - the position, fields separated by spaces
+ * @param side - set to the color to move
+ * @return - whether the position was understood, the board is unchanged if not
+ */
+bool Board::loadFen(const std::string &fen, bool &side) {
+	std::istringstream in(fen);
+	std::string placement, toMove, rights, enPassant;
+	if (!(in >> placement >> toMove)) { return false; }
+	if (!(in >> rights)) { rights = "-"; }
+	unsigned int clock = 0;
+	in >> enPassant >> clock;
+	if (toMove != "w" && toMove != "b") { return false; }
+	// read the placement onto a scratch board first
+	Board b(*this);
+	b.castling = 0;
+	b.clearBoard();
+	b.halfmoves = clock;
+	const std::string types = "pnbrqk";
+	unsigned int c = 0, r = ROWS - 1;
+	for (unsigned int i = 0; i < placement.size(); i++) {
+		char ch = placement[i];
+		if (ch == '/') {
+			// a row must be filled before moving down to the next
+			if (c != COLS || r == 0) { return false; }
+			c = 0; r--;
+		} else if (ch >= '1' && ch <= '8') {
+			c += ch - '0';
+			if (c > COLS) { return false; }
+		} else {
+			size_t t = types.find(tolower(ch));
+			if (t == std::string::npos || c >= COLS) { return false; }
+			b.putPiece(isupper(ch) != 0, t, Bitboards::index(c, r));
+			c++;
 		}
-		// if you get here, no move gets out of check
-		return true;
 	}
-	return false; // if not in check, can't be checkmate
+	if (c != COLS || r != 0) { return false; }
+	// exactly one king each, and no pawns left unpromoted on the far rows
+	Bitboard farRows = Bitboards::square(A, 0) * 0xFF;
+	farRows |= Bitboards::square(A, ROWS - 1) * 0xFF;
+	for (unsigned int i = BLACK; i <= WHITE; i++) {
+		if (Bitboards::popCount(b.pieces[i][Piece::KING]) != 1) {
+			return false;
+		}
+		if (b.pieces[i][Piece::PAWN] & farRows) { return false; }
+	}
+	const std::string flags = "KQkq";
+	const unsigned int masks[] = {
+		CASTLE_WHITE_EAST, CASTLE_WHITE_WEST,
+		CASTLE_BLACK_EAST, CASTLE_BLACK_WEST
+	};
+	for (unsigned int i = 0; i < flags.size(); i++) {
+		if (rights.find(flags[i]) == std::string::npos) { continue; }
+		bool color = (i < 2);
+		unsigned int row = (color) ? 0 : ROWS - 1;
+		unsigned int rook = Bitboards::index((i % 2 == 0) ? H : A, row);
+		bool home = (b.pieces[color][Piece::KING] & Bitboards::square(E, row));
+		home = home && (b.pieces[color][Piece::ROOK] & Bitboards::bit(rook));
+		if (home) { b.castling |= masks[i]; }
+	}
+	b.key ^= Zobrist::castling[0] ^ Zobrist::castling[b.castling];
+	// the key counts moves made from white to move
+	side = (toMove == "w");
+	if (!side) { b.key ^= Zobrist::side; }
+	*this = b;
+	return true;
+}
+
+/**
+ * method to write a move in the coordinate notation of the Universal Chess
+ * Interface. A castling king moves two tiles there rather than onto its rook,
+ * and a promotion names the piece, always a queen here
+ * @param m - the move, to be made in this position
+ * @return - the move, e.g. "e1g1" or "a7a8q"
+ */
+std::string Board::toUci(Move m) const {
+	unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+	unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+	bool color = (colors[WHITE] & Bitboards::bit(orig)) != 0;
+	unsigned int type = getType(color, orig);
+	bool ontoRook = (pieces[color][Piece::ROOK] & Bitboards::bit(dest)) != 0;
+	std::string s = m.stateMove();
+	if (type == Piece::KING && ontoRook) {
+		s[2] = 'a' + ((m.getDestC() > m.getOrigC()) ? G : C);
+	} else if (type == Piece::PAWN && m.getDestR() == ((color) ? ROWS-1 : 0)) {
+		s += 'q';
+	}
+	return s;
+}
+
+/**
+ * method to place a piece on an empty square
+ * @param c - the color of the piece
+ * @param t - the type of the piece
+ * @param s - the square index
+ */
+inline void Board::putPiece(bool c, unsigned int t, unsigned int s) {
+	pieces[c][t] |= Bitboards::bit(s);
+	colors[c] |= Bitboards::bit(s);
+	occupied |= Bitboards::bit(s);
+	key ^= Zobrist::pieces[c][t][s];
+	material[c] += GameParams::VALUES[t];
+	if (t == Piece::PAWN) { pawnRanks[c] += pawnRank(c, s); }
+}
+
+/**
+ * method to take a piece off its square
+ * @param c - the color of the piece
+ * @param t - the type of the piece
+ * @param s - the square index
+ */
+inline void Board::removePiece(bool c, unsigned int t, unsigned int s) {
+	pieces[c][t] &= ~Bitboards::bit(s);
+	colors[c] &= ~Bitboards::bit(s);
+	occupied &= ~Bitboards::bit(s);
+	key ^= Zobrist::pieces[c][t][s];
+	material[c] -= GameParams::VALUES[t];
+	if (t == Piece::PAWN) { pawnRanks[c] -= pawnRank(c, s); }
+}
+
+/**
+ * method to find how far a pawn has advanced from its initial row
+ * @param c - the color of the pawn
+ * @param s - the square index of the pawn
+ * @return - the number of rows advanced
+ */
+inline int Board::pawnRank(bool c, unsigned int s) const {
+	// white pawns are on second row initially, black on seventh
+	return (c == WHITE) ? (int)(s / COLS) - 1 : 6 - (int)(s / COLS);
+}
+
+/**
+ * method to find the type of piece on a square
+ * @param c - the color of the piece
+ * @param s - the square index
+ * @return - the piece type index, or Piece::TYPES if none of that color
+ */
+unsigned int Board::getType(bool c, unsigned int s) const {
+	for (unsigned int i = 0; i < Piece::TYPES; i++) {
+		if (pieces[c][i] & Bitboards::bit(s)) { return i; }
+	}
+	return Piece::TYPES;
+}
+
+/**
+ * method to find which castling rights survive a move touching a square
+ * @param s - the square index
+ * @return - mask of rights kept
+ */
+inline unsigned int Board::castleMask(unsigned int s) const {
+	if (s == Bitboards::index(E, 0)) {
+		return ~(CASTLE_WHITE_EAST | CASTLE_WHITE_WEST);
+	} else if (s == Bitboards::index(H, 0)) {
+		return ~CASTLE_WHITE_EAST;
+	} else if (s == Bitboards::index(A, 0)) {
+		return ~CASTLE_WHITE_WEST;
+	} else if (s == Bitboards::index(E, ROWS-1)) {
+		return ~(CASTLE_BLACK_EAST | CASTLE_BLACK_WEST);
+	} else if (s == Bitboards::index(H, ROWS-1)) {
+		return ~CASTLE_BLACK_EAST;
+	} else if (s == Bitboards::index(A, ROWS-1)) {
+		return ~CASTLE_BLACK_WEST;
+	}
+	return ~0u;
+}
+
+/**
+ * method to find the legal moves of the player to move along with the state
+ * of the game, generating the moves only once for every question
+ * @param c - the player to move
+ * @param s - the record to fill
+ */
+void Board::classify(bool c, Status &s) {
+	s.moves.clear();
+	getAllMoves(!c, s.moves);
+	s.check = determineCheck(c);
+	// with no legal move, the game is over one way or the other
+	bool none = s.moves.size() == 0;
+	s.checkmate = s.check && none;
+	s.stalemate = !s.check && none;
+	s.draw = determineDraw();
+}
+
+/**
+ * method to find the classification of the position, see classify, kept
+ * until the position next changes so that the game loop, the players and the
+ * AI's root all share one generation of the moves each turn. Search makes and
+ * unmakes moves on the board, so it classifies its nodes for itself
+ * @param c - the player to move
+ * @return - the legal moves and the state of the game
+ */
+const Status& Board::getStatus(bool c) {
+	if (statusVersion != version || statusSide != c) {
+		classify(c, status);
+		statusVersion = version;
+		statusSide = c;
+	}
+	return status;
 }
 
 /**
@@ -138,172 +374,404 @@ bool Board::determineCheckmate(bool c) {
  * @return - whether that player is in check
  */
 bool Board::determineCheck(bool c) {
-	// get all moves of opponent
-	std::vector<Move> moveList = getAllNonKingMoves(c);
-	// for each of those moves
-	for (unsigned int i = 0; i < moveList.size(); i++) {
-		// compare the destination to see if it coincides with king
-		Tile t = (*this)(moveList[i].getDestC(), moveList[i].getDestR());
-		if (t && t.getPiece().getType() == ((c) ? 'K' : 'k')) {
-			return true;
-		}
+	Bitboard king = pieces[c][Piece::KING];
+	if (!king) { return false; }
+	return isSquareAttacked(Bitboards::lsb(king), !c);
+}
+
+/**
+ * method to determine if a square is attacked, rather than generating the
+ * attacker's moves this looks outward from the square: it is attacked by a
+ * piece exactly when that piece type standing on the square would attack it
+ * @param s - the square index
+ * @param c - the attacking color
+ * @return - whether any piece of that color attacks the square
+ */
+bool Board::isSquareAttacked(unsigned int s, bool c) const {
+	return isSquareAttacked(s, c, occupied);
+}
+
+/**
+ * method to determine if a square is attacked given which tiles block the
+ * sliders, used to test squares with a piece lifted off the board
+ * @param s - the square index
+ * @param c - the attacking color
+ * @param occ - the occupied tiles
+ * @return - whether any piece of that color attacks the square
+ */
+bool Board::isSquareAttacked(unsigned int s, bool c, Bitboard occ) const {
+	// pawns attack diagonally forward, so look diagonally backward for them
+	if (Bitboards::pawnAttacks(!c, s) & pieces[c][Piece::PAWN]) {
+		return true;
 	}
-	return false;
+	if (Bitboards::knightAttacks(s) & pieces[c][Piece::KNIGHT]) {
+		return true;
+	}
+	if (Bitboards::kingAttacks(s) & pieces[c][Piece::KING]) { return true; }
+	// sliders attack along the rays they share with a queen
+	Bitboard diagonal = pieces[c][Piece::BISHOP] | pieces[c][Piece::QUEEN];
+	if (Bitboards::bishopAttacks(s, occ) & diagonal) { return true; }
+	Bitboard straight = pieces[c][Piece::ROOK] | pieces[c][Piece::QUEEN];
+	return Bitboards::rookAttacks(s, occ) & straight;
+}
+
+/**
+ * method to find every piece of either color attacking a square
+ * @param s - the square index
+ * @param occ - the occupied tiles, which block the sliders
+ * @return - the attacking pieces
+ */
+Bitboard Board::getAttackers(unsigned int s, Bitboard occ) const {
+	Bitboard attackers = 0;
+	// as isSquareAttacked, look outward from the square
+	for (unsigned int c = BLACK; c <= WHITE; c++) {
+		const Bitboard* set = pieces[c];
+		attackers |= Bitboards::pawnAttacks(!c, s) & set[Piece::PAWN];
+		attackers |= Bitboards::knightAttacks(s) & set[Piece::KNIGHT];
+		attackers |= Bitboards::kingAttacks(s) & set[Piece::KING];
+		Bitboard diagonal = set[Piece::BISHOP] | set[Piece::QUEEN];
+		attackers |= Bitboards::bishopAttacks(s, occ) & diagonal;
+		Bitboard straight = set[Piece::ROOK] | set[Piece::QUEEN];
+		attackers |= Bitboards::rookAttacks(s, occ) & straight;
+	}
+	return attackers & occ;
 }
 
 /**
- * method to determine if a player is in stalemate
- * @param c - the player to check
- * @return - whether that player is in stalemate
+ * static exchange evaluation, works out what a capture wins once both players
+ * have taken back on the square with their least valuable attackers for as
+ * long as it pays them. Each capture lifts its piece off the board, so sliders
+ * lined up behind it (x-rays) join in. Either player may stop taking at any
+ * point, which the scores are resolved back through from the end
+ * @param m - the move, a capture or otherwise
+ * @return - the material it wins, negative if it loses material
  */
-bool Board::determineStalemate(bool c) {
-	// cannot be in stalemate if in check
-	if (determineCheck(c)) { return false; }
-	// if you cannot make any moves, it is a stalemate
-	if (getAllMoves(!c).size() == 0) { return true; }
-	return false; // all else, not stalemate
+int Board::see(Move m) const {
+	unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+	unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+	bool side = (colors[WHITE] & Bitboards::bit(orig)) != 0;
+	// castling onto an own rook wins nothing
+	if (colors[side] & Bitboards::bit(dest)) { return 0; }
+	unsigned int victim = getType(!side, dest);
+	unsigned int attacker = getType(side, orig);
+	// gain[i] is what the i-th capture wins should the exchange stop there
+	int gain[32];
+	unsigned int i = 0;
+	gain[0] = (victim == Piece::TYPES) ? 0 : GameParams::VALUES[victim];
+	Bitboard occ = occupied;
+	Bitboard from = Bitboards::bit(orig);
+	Bitboard attackers = getAttackers(dest, occ);
+	while (i < 31) {
+		i++;
+		// the piece just moved onto the square is what the next capture takes
+		gain[i] = GameParams::VALUES[attacker] - gain[i-1];
+		occ &= ~from;
+		// uncover sliders behind the piece which moved
+		attackers |= getAttackers(dest, occ);
+		attackers &= occ;
+		side = !side;
+		// the least valuable attacker takes next
+		from = 0;
+		for (unsigned int t = 0; t < Piece::TYPES && !from; t++) {
+			Bitboard set = attackers & pieces[side][t];
+			if (set) { from = set & (0 - set); attacker = t; }
+		}
+		if (!from) { break; }
+	}
+	// each player takes only when it beats stopping
+	while (--i) { gain[i-1] = -std::max(-gain[i-1], gain[i]); }
+	return gain[0];
 }
 
 /**
- * method to determine a draw has occurred
+ * method to determine a draw has occurred, by threefold repetition, the fifty
+ * move rule or neither player having the material left to checkmate
  * @return - whether a draw has occurred
  */
 bool Board::determineDraw() {
-	// determine if only the two kings exist
-	int countKings = 0;
-	for (unsigned int i = 0; i < COLS; i++) {
-		for (unsigned int j = 0; j < ROWS; j++) {
-			if ((*this)(j, i)) { // if piece exists
-				countKings += (*this)(j, i).getPiece().getValue();
-			}
-		}
+	if (countRepetitions() >= 2 || isFiftyMoves()) { return true; }
+	return isInsufficientMaterial();
+}
+
+/**
+ * method to determine if the position has been seen before, search treats a
+ * single repetition as a draw as whatever was played from it may be again.
+ * Only positions since the last capture or pawn move can be the same, and
+ * only every other one has the same player to move
+ * @return - whether the position has occurred before
+ */
+bool Board::isRepetition() const {
+	unsigned int n = std::min(halfmoves, plies);
+	if (n >= KEY_HISTORY) { n = KEY_HISTORY - 1; }
+	for (unsigned int i = 4; i <= n; i += 2) {
+		if (keys[(plies - i) % KEY_HISTORY] == key) { return true; }
 	}
-	// two kings would have board value equal to two kings
-	return (countKings == 2 * GameParams::K_VAL);
+	return false;
 }
 
 /**
- * method to find all moves possible
- * @param c - the color to look for
- * @return - a list of moves for player
+ * method to count the earlier occurrences of the position, see isRepetition
+ * @return - how many times the position has occurred before
  */
-std::vector<Move> Board::getAllMoves(bool c) {
-	std::vector<Move> moveList; // master move list
-	for (unsigned int i = 0; i < COLS; i++) {
-		for (unsigned int j = 0; j < ROWS; j++) {
-			// short circuit in case non-occupied tile or wrong color
-			if (!(*this)(j, i) || (*this)(j, i).getPiece().getColor() == c) {
-				continue;
-			}
-			// collect moves from tiled piece
-			std::vector<Move> m = (*this)(j,i).getPiece().getMoves(this, j, i);
-			for (unsigned int k = 0; k < m.size(); k++) {
-				// append those moves to the master list
-				moveList.push_back(m[k]);
-			}
-		}
+unsigned int Board::countRepetitions() const {
+	unsigned int n = std::min(halfmoves, plies);
+	if (n >= KEY_HISTORY) { n = KEY_HISTORY - 1; }
+	unsigned int count = 0;
+	for (unsigned int i = 4; i <= n; i += 2) {
+		if (keys[(plies - i) % KEY_HISTORY] == key) { count++; }
 	}
-	return moveList;
+	return count;
+}
+
+/**
+ * method to determine if fifty moves each have gone by without a capture or
+ * a pawn move
+ * @return - whether the fifty move rule draws the game
+ */
+bool Board::isFiftyMoves() const {
+	return halfmoves >= FIFTY_MOVES;
 }
 
 /**
- * method to find all moves possible except by K, a separate function is needed
- * to avoid infinite recursion when >1 king is on the board
+ * method to determine if neither player can possibly checkmate: a lone king
+ * each, a single knight or bishop besides them, or only bishops which all
+ * stand on tiles of one color
+ * @return - whether there is too little material to checkmate
+ */
+bool Board::isInsufficientMaterial() const {
+	Bitboard heavy = 0, knights = 0, bishops = 0;
+	for (unsigned int i = BLACK; i <= WHITE; i++) {
+		heavy |= pieces[i][Piece::PAWN] | pieces[i][Piece::ROOK];
+		heavy |= pieces[i][Piece::QUEEN];
+		knights |= pieces[i][Piece::KNIGHT];
+		bishops |= pieces[i][Piece::BISHOP];
+	}
+	if (heavy) { return false; }
+	if (Bitboards::popCount(knights | bishops) <= 1) { return true; }
+	if (knights) { return false; }
+	return !(bishops & DARK) || !(bishops & ~DARK);
+}
+
+/**
+ * method to find all legal moves possible, those leaving the mover's own king
+ * in check are never generated
  * @param c - the color to look for
- * @return - a list of moves for player
+ * @param moveList - the list to append the moves for player to
  */
-std::vector<Move> Board::getAllNonKingMoves(bool c) {
-	std::vector<Move> moveList; // master move list
-	for (unsigned int i = 0; i < COLS; i++) {
-		for (unsigned int j = 0; j < ROWS; j++) {
-			// short circuit in case non-occupied tile or wrong color
-			if (!(*this)(j, i) || (*this)(j, i).getPiece().getColor() == c) {
-				continue;
-			}
-			// disregard kings as legally they cannot be next to each other
-			if ((*this)(j, i).getPiece().getType() == ((c) ? 'k' : 'K')) {
-				continue;
-			}
-			// collect moves from tiled piece
-			std::vector<Move> m = (*this)(j,i).getPiece().getMoves(this, j, i);
-			for (unsigned int k = 0; k < m.size(); k++) {
-				// append those moves to the master list
-				moveList.push_back(m[k]);
-			}
-		}
+void Board::getAllMoves(bool c, MoveList &moveList) {
+	getTargetMoves(c, moveList, ~0ULL);
+}
+
+/**
+ * method to find only the capturing moves, for search to try before the rest
+ * @param c - the color to look for, as getAllMoves
+ * @param moveList - the list to append the captures to
+ */
+void Board::getCaptures(bool c, MoveList &moveList) {
+	getTargetMoves(c, moveList, colors[c]);
+}
+
+/**
+ * method to find only the non-capturing moves, which with getCaptures makes up
+ * getAllMoves (castling lands on an own rook, so own tiles are allowed)
+ * @param c - the color to look for, as getAllMoves
+ * @param moveList - the list to append the moves to
+ */
+void Board::getQuiets(bool c, MoveList &moveList) {
+	getTargetMoves(c, moveList, ~colors[c]);
+}
+
+/**
+ * method to find only the promotions which do not capture, these and the
+ * captures are the moves which change the material on the board
+ * @param c - the color to look for, as getAllMoves
+ * @param moveList - the list to append the promotions to
+ */
+void Board::getPromotions(bool c, MoveList &moveList) {
+	const Bitboard ROW = 0xFFULL; // the first row
+	// only pawns one row short of the far row can promote
+	unsigned int last = (!c == WHITE) ? ROWS-1 : 0;
+	unsigned int next = (!c == WHITE) ? ROWS-2 : 1;
+	Bitboard set = pieces[!c][Piece::PAWN] & (ROW << (next * COLS));
+	Bitboard mask = (ROW << (last * COLS)) & ~colors[c];
+	if (!set) { return; }
+	Bitboard pinned = getPinned(!c);
+	Bitboard evasions = getEvasions(!c, getCheckers(!c));
+	while (set) {
+		unsigned int s = Bitboards::popLsb(set);
+		Bitboard k = mask & legalMask(!c, s, pinned, evasions);
+		if (k) { getPieceMoves(!c, Piece::PAWN, s, moveList, k); }
+	}
+}
+
+/**
+ * method to find the moves ending on a set of tiles
+ * @param c - the color to look for, as getAllMoves
+ * @param moveList - the list to append the moves to
+ * @param mask - the tiles the moves may end on
+ */
+void Board::getTargetMoves(bool c, MoveList &moveList, Bitboard mask) {
+	// the checks and pins are found once for every piece
+	Bitboard pinned = getPinned(!c);
+	Bitboard evasions = getEvasions(!c, getCheckers(!c));
+	// visit the opposing color's pieces in a1, b1, ..., h8 order
+	Bitboard set = colors[!c];
+	while (set) {
+		unsigned int s = Bitboards::popLsb(set);
+		Bitboard k = mask & legalMask(!c, s, pinned, evasions);
+		// append moves from that piece to the master list
+		if (k) { getPieceMoves(!c, getType(!c, s), s, moveList, k); }
+	}
+}
+
+/**
+ * method to find the pieces giving check
+ * @param c - the color of the king in check
+ * @return - the opposing pieces attacking that king
+ */
+Bitboard Board::getCheckers(bool c) const {
+	Bitboard king = pieces[c][Piece::KING];
+	if (!king) { return 0; }
+	return getAttackers(Bitboards::lsb(king), occupied) & colors[!c];
+}
+
+/**
+ * method to find the pieces pinned to their king, which are the only pieces
+ * standing between it and an opposing slider on the same line
+ * @param c - the color of the king
+ * @return - that color's pinned pieces
+ */
+Bitboard Board::getPinned(bool c) const {
+	Bitboard king = pieces[c][Piece::KING];
+	if (!king) { return 0; }
+	unsigned int k = Bitboards::lsb(king);
+	// sliders which would attack the king over an empty board
+	Bitboard diagonal = pieces[!c][Piece::BISHOP] | pieces[!c][Piece::QUEEN];
+	Bitboard straight = pieces[!c][Piece::ROOK] | pieces[!c][Piece::QUEEN];
+	Bitboard snipers = Bitboards::bishopAttacks(k, 0) & diagonal;
+	snipers |= Bitboards::rookAttacks(k, 0) & straight;
+	Bitboard pinned = 0;
+	while (snipers) {
+		Bitboard b = Bitboards::between(k, Bitboards::popLsb(snipers));
+		b &= occupied;
+		if (Bitboards::popCount(b) == 1) { pinned |= b & colors[c]; }
 	}
-	return moveList;
+	return pinned;
 }
 
 /**
- * method to count the piece values of all pieces
+ * method to find where a piece other than the king must move to get out of
+ * check: onto the checking piece or between it and the king. In double check
+ * only the king may move
+ * @param c - the color of the king
+ * @param checkers - the pieces giving check, see getCheckers
+ * @return - the tiles non-king moves may end on, every tile if not in check
+ */
+Bitboard Board::getEvasions(bool c, Bitboard checkers) const {
+	if (!checkers) { return ~0ULL; }
+	if (Bitboards::popCount(checkers) > 1) { return 0; }
+	unsigned int k = Bitboards::lsb(pieces[c][Piece::KING]);
+	return checkers | Bitboards::between(k, Bitboards::lsb(checkers));
+}
+
+/**
+ * method to find the tiles a piece may move to without leaving its king in
+ * check, a pinned piece keeps to the line through its king. The king finds
+ * its own safe tiles as it generates its moves
+ * @param c - the color of the piece
+ * @param s - the square index of the piece
+ * @param pinned - that color's pinned pieces, see getPinned
+ * @param evasions - the tiles which get out of any check, see getEvasions
+ * @return - the tiles the piece may legally end on
+ */
+inline Bitboard Board::legalMask(bool c, unsigned int s, Bitboard pinned,
+									Bitboard evasions) const {
+	if (pieces[c][Piece::KING] & Bitboards::bit(s)) { return ~0ULL; }
+	if (!(pinned & Bitboards::bit(s))) { return evasions; }
+	unsigned int k = Bitboards::lsb(pieces[c][Piece::KING]);
+	return evasions & Bitboards::line(k, s);
+}
+
+/**
+ * method to determine if a move is legal for a player, used to check a move
+ * remembered from another position before making it
+ * @param c - the color of the moving player
+ * @param m - the move
+ * @return - whether one of that player's pieces legally makes the move
+ */
+bool Board::isLegal(bool c, Move m) {
+	unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+	unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+	unsigned int t = getType(c, orig);
+	if (t == Piece::TYPES) { return false; }
+	Bitboard evasions = getEvasions(c, getCheckers(c));
+	Bitboard k = Bitboards::bit(dest);
+	k &= legalMask(c, orig, getPinned(c), evasions);
+	if (!k) { return false; }
+	MoveList moveList;
+	getPieceMoves(c, t, orig, moveList, k);
+	return moveList.size() > 0;
+}
+
+/**
+ * method to find the moves of a single piece
+ * @param c - the color of the piece
+ * @param t - the type of the piece
+ * @param s - the square index of the piece
+ * @param m - the list to append the moves for that piece to
+ * @param k - the tiles the moves may end on
+ */
+void Board::getPieceMoves(bool c, unsigned int t, unsigned int s,
+							MoveList &m, Bitboard k) {
+	Piece::get(c, t).getMoves(this, s % COLS, s / COLS, m, k);
+}
+
+/**
+ * method to count the moves of a single piece without building them
+ * @param c - the color of the piece
+ * @param t - the type of the piece
+ * @param s - the square index of the piece
+ * @return - the number of moves getPieceMoves would find
+ */
+unsigned int Board::countPieceMoves(bool c, unsigned int t, unsigned int s) {
+	return Piece::get(c, t).countMoves(this, s % COLS, s / COLS);
+}
+
+/**
+ * method to count the piece values of all pieces, the totals are kept as
+ * pieces are placed and removed so this is only a subtraction
  * @param c - the color to check pieces for values
  * @return - the total value of those colored pieces
  */
 int Board::getAllPieceValues(bool c) {
-	int count = 0;
-	for (unsigned int i = 0; i < COLS; i++) {
-		for (unsigned int j = 0; j < ROWS; j++) {
-			if ((*this)(j, i)) {
-				// if piece exists and right color
-				if ((*this)(j, i).getPiece().getColor() == c) {
-					count += (*this)(j, i).getPiece().getValue();
-				} else {
-					count -= (*this)(j, i).getPiece().getValue();
-				}
-			}
-		}
-	}
-	return count;
+	return material[c] - material[!c];
 }
 
 /**
- * method to find mobility value of the board
+ * method to find mobility value of the board, the moves of each piece are
+ * counted from its attacked tiles rather than generated
  * @param c - the color to check for
  * @return - total mobility score
  */
 int Board::getAllMobilityValues(bool c) {
 	int count = 0;
-	for (unsigned int i = 0; i < COLS; i++) {
-		for (unsigned int j = 0; j < ROWS; j++) {
-			if (!(*this)(j, i)) { continue; } // only if piece exists
-			// if piece exists and right color
-			if ((*this)(j, i).getPiece().getColor() == c) {
-				count += (*this)(j, i).getPiece().getMoves(this, j, i).size();
-			} else {
-				count -= (*this)(j, i).getPiece().getMoves(this, j, i).size();
-			}
-		}
+	for (unsigned int i = 0; i < Piece::TYPES; i++) {
+		Bitboard set = pieces[c][i];
+		while (set) { count += countPieceMoves(c, i, Bitboards::popLsb(set)); }
+		// the opposing color's moves count against
+		set = pieces[!c][i];
+		while (set) { count -= countPieceMoves(!c, i, Bitboards::popLsb(set)); }
 	}
 	return count;
 }
 
 /**
- * method to determine pawn control
+ * method to determine pawn control, kept up to date like the piece values
  * @param c - the color to check for
  * @return - the total pawn control
  */
 int Board::getAllPawnValues(bool c) {
-	int count = 0;
-	for (unsigned int i = 0; i < COLS; i++) {
-		for (unsigned int j = 0; j < ROWS; j++) {
-			// if piece exists
-			if ((*this)(j, i)) {
-				// and is pawn
-				if ((*this)(j, i).getPiece().getValue() == GameParams::P_VAL) {
-					// if matching color
-					if ((*this)(j, i).getPiece().getColor() == c) {
-						// white pawns are on second row initially
-						count += ((c == WHITE) ? i-1 : 6-i);
-					} else {
-						// black pawns are on seventh row initially
-						count -= ((c == WHITE) ? 6-i : i-1);
-					}
-				}
-			}
-		}
-	}
-	return count;
+	return pawnRanks[c] - pawnRanks[!c];
 }
 
 // method to print the game board to console
@@ -341,7 +809,7 @@ void Board::printBoard() {
  * @param r - the row coordinate of the piece
  * @param m - the movelist from caller
  */
-void Board::showMoves(unsigned int c, unsigned int r, std::vector<Move> m) {
+void Board::showMoves(unsigned int c, unsigned int r, const MoveList &m) {
 	std::stringstream sb;
 	std::vector<Move> moveList;
 	// init a blank move with origin the same
@@ -405,11 +873,37 @@ void Board::showMoves(unsigned int c, unsigned int r, std::vector<Move> m) {
 	}
 }
 
-// operator methods
-Tile& Board::operator()(unsigned int c, unsigned int r) {
-	return tiles[c][r];
+// accessor methods
+Bitboard Board::getPieces(bool c, unsigned int t) const { return pieces[c][t]; }
+Bitboard Board::getColorPieces(bool c) const { return colors[c]; }
+Bitboard Board::getOccupied() const { return occupied; }
+uint64_t Board::getKey() const { return key; }
+unsigned int Board::getHalfmoves() const { return halfmoves; }
+
+/**
+ * method to determine if a color keeps the right to castle
+ * @param c - the color to check
+ * @param e - true for the east (H) rook, false for the west (A) rook
+ * @return - whether neither king nor that rook has moved
+ */
+bool Board::canCastle(bool c, bool e) const {
+	if (c == WHITE) {
+		return castling & ((e) ? CASTLE_WHITE_EAST : CASTLE_WHITE_WEST);
+	}
+	return castling & ((e) ? CASTLE_BLACK_EAST : CASTLE_BLACK_WEST);
 }
 
-Tile const& Board::operator()(unsigned int c, unsigned int r) const {
-	return tiles[c][r];
-}
\ No newline at end of file
+/**
+ * operator to view a tile, the console output works on tiles so one is built
+ * from the bitboards on request
+ * @param c - the columnar coordinate
+ * @param r - the row coordinate
+ * @return - a tile holding the piece there, if any
+ */
+Tile Board::operator()(unsigned int c, unsigned int r) const {
+	unsigned int s = Bitboards::index(c, r);
+	bool color = (colors[WHITE] & Bitboards::bit(s)) != 0;
+	unsigned int t = getType(color, s);
+	if (t == Piece::TYPES) { return Tile(); }
+	return Tile(&Piece::get(color, t));
+}
@@ -1,48 +1,121 @@
 #pragma once
 #include "Tile.hpp"
-#include "../Game/GameParams.hpp"
-#include "../pieces/Knight.hpp"
-#include "../pieces/Bishop.hpp"
-#include "../pieces/Rook.hpp"
-#include "../pieces/Queen.hpp"
-#include "../pieces/King.hpp"
-#include "../pieces/Pawn.hpp"
+#include "Bitboards.hpp"
+#include "Undo.hpp"
+#include "Status.hpp"
+#include "Zobrist.hpp"
+#include "../game/GameParams.hpp"
 #include <fstream>
+#include <sstream>
+#include <algorithm>
 
 // Board class declaration
 
 class Board {
 	private:
-		Tile tiles[8][8]; // how the board is organized
+		/**
+		 * how the board is organized: one set per color and piece type, with
+		 * colors indexed by the bool color itself (BLACK = 0, WHITE = 1) and
+		 * piece types by the Piece type indices
+		 */
+		Bitboard pieces[2][Piece::TYPES];
+		Bitboard colors[2]; // occupancy per color
+		Bitboard occupied; // occupancy of both colors
+		unsigned int castling; // castling rights, see CASTLE_ below
+		uint64_t key; // Zobrist key, kept up to date by every move
+		unsigned int halfmoves; // plies since the last capture or pawn move
+		/**
+		 * the keys before each move, kept in a ring so that copying a board
+		 * never allocates. A repetition only reaches back to the last capture
+		 * or pawn move, under fifty moves plus the search depth, so only the
+		 * latest KEY_HISTORY keys are ever read
+		 */
+		const static unsigned int KEY_HISTORY = 256;
+		uint64_t keys[KEY_HISTORY];
+		unsigned int plies; // moves made, indexing the next free slot of keys
+		// evaluation terms per color, kept up to date alongside the key
+		int material[2]; // total piece value
+		int pawnRanks[2]; // total rows pawns have advanced
+		// the last classification, kept until the position changes
+		uint64_t version; // counts every change made to the position
+		Status status; // see getStatus
+		uint64_t statusVersion; // the version status was found for
+		bool statusSide; // the player status was found for
 
 		const static bool WHITE = true, BLACK = false;
 		const static unsigned int A=0, B=1, C=2, D=3, E=4, F=5, G=6, H=7;
 		const static unsigned int COLS = 8, ROWS = 8;
+		// plies without a capture or pawn move before the game is drawn
+		const static unsigned int FIFTY_MOVES = 100;
+		// the dark tiles, a1 among them
+		const static Bitboard DARK = 0xAA55AA55AA55AA55ULL;
+
+		// castling rights, cleared once the king or that rook leaves home
+		const static unsigned int CASTLE_WHITE_EAST = 1, CASTLE_WHITE_WEST = 2;
+		const static unsigned int CASTLE_BLACK_EAST = 4, CASTLE_BLACK_WEST = 8;
 
 		// private member methods
 		void initNormalBoard();
-		std::vector<Move> getAllNonKingMoves(bool);
+		void clearBoard();
+		void putPiece(bool, unsigned int, unsigned int);
+		void removePiece(bool, unsigned int, unsigned int);
+		unsigned int castleMask(unsigned int) const;
+		int pawnRank(bool, unsigned int) const;
+		void getPieceMoves(bool, unsigned int, unsigned int, MoveList&,
+							Bitboard);
+		void getTargetMoves(bool, MoveList&, Bitboard);
+		Bitboard getCheckers(bool) const;
+		Bitboard getPinned(bool) const;
+		Bitboard getEvasions(bool, Bitboard) const;
+		Bitboard legalMask(bool, unsigned int, Bitboard, Bitboard) const;
+		unsigned int countPieceMoves(bool, unsigned int, unsigned int);
 	public:
 		Board(); // constructor
 
 		// public member methods
+		bool loadFen(const std::string&, bool&);
+		std::string toUci(Move) const;
 		void printBoard();
-		void showMoves(unsigned int, unsigned int, std::vector<Move>);
+		void showMoves(unsigned int, unsigned int, const MoveList&);
 		void movePiece(Move);
-		std::vector<Move> getAllMoves(bool);
+		void makeMove(Move, Undo&);
+		void unmakeMove(Move, const Undo&);
+		void makeNullMove(Undo&);
+		void unmakeNullMove(const Undo&);
+		void getAllMoves(bool, MoveList&);
+		void getCaptures(bool, MoveList&);
+		void getQuiets(bool, MoveList&);
+		void getPromotions(bool, MoveList&);
+		bool isLegal(bool, Move);
 
 		// determine board state
-		bool determineCheckmate(bool);
-		bool determineStalemate(bool);
+		void classify(bool, Status&);
+		const Status& getStatus(bool);
 		bool determineCheck(bool);
+		bool isSquareAttacked(unsigned int, bool) const;
+		bool isSquareAttacked(unsigned int, bool, Bitboard) const;
+		Bitboard getAttackers(unsigned int, Bitboard) const;
+		int see(Move) const;
 		bool determineDraw();
+		bool isRepetition() const;
+		unsigned int countRepetitions() const;
+		bool isFiftyMoves() const;
+		bool isInsufficientMaterial() const;
 
 		// determine heuristic evaluation values
 		int getAllPieceValues(bool);
 		int getAllMobilityValues(bool);
 		int getAllPawnValues(bool);
 
+		// accessor methods
+		Bitboard getPieces(bool, unsigned int) const;
+		unsigned int getType(bool, unsigned int) const;
+		Bitboard getColorPieces(bool) const;
+		Bitboard getOccupied() const;
+		bool canCastle(bool, bool) const;
+		uint64_t getKey() const;
+		unsigned int getHalfmoves() const;
+
 		// operator methods
-		Tile& operator()(unsigned int, unsigned int);
-		Tile const& operator()(unsigned int, unsigned int) const;
+		Tile operator()(unsigned int, unsigned int) const;
 };
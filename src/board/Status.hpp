@@ -0,0 +1,16 @@
+#pragma once
+#include "../game/MoveList.hpp"
+
+/**
+ * Status record declaration, filled by Board::classify with the legal moves
+ * of the player to move and what they make of the position, so the game loop
+ * generates the moves once and reads everything from them
+ */
+
+struct Status {
+	MoveList moves; // the legal moves
+	bool check; // whether the player to move is in check
+	bool checkmate; // in check with no legal move
+	bool stalemate; // not in check with no legal move
+	bool draw; // drawn by repetition, the fifty move rule or material
+};
@@ -2,34 +2,25 @@
 
 // Tile class definition
 
-// constructors and destructors
+// constructors
 Tile::Tile() : occupant(NULL) {}
-Tile::Tile(Piece* p) : occupant(p) {}
-Tile::~Tile() { occupant.reset(); }
-Tile::Tile(const Tile& t)
-	: occupant(t ? t.occupant->clone() : std::shared_ptr<Piece>()) {}
+Tile::Tile(const Piece* p) : occupant(p) {}
 
-// explicit "destructor"
-void Tile::reset() { occupant.reset(); }
+// explicit "destructor", the piece is shared so it is only let go
+void Tile::reset() { occupant = NULL; }
 
 // accessor methods
-Piece& Tile::getPiece() { return *occupant; }
+const Piece& Tile::getPiece() const { return *occupant; }
 
 // operator methods
-Tile& Tile::operator=(const Tile& t) {
-	Tile temp(t);
-	occupant = temp.occupant;
+Tile& Tile::operator=(const Piece* p) {
+	occupant = p;
 	return *this;
 }
 
-Tile& Tile::operator=(Piece* p) {
-	occupant.reset(p);
-	return *this;
-}
-
-Tile::operator bool() const { return occupant.get() != NULL; }
+Tile::operator bool() const { return occupant != NULL; }
 
-std::ostream& operator<<(std::ostream &out, Tile &t) {
-	out << (t ? t.occupant.get()->getType() : ' ');
+std::ostream& operator<<(std::ostream &out, const Tile &t) {
+	out << (t ? t.occupant->getType() : ' ');
 	return out;
 }
@@ -2,26 +2,26 @@
 #include <iostream>
 #include "../pieces/Piece.hpp"
 
-// Tile class declaration
+/**
+ * Tile class declaration, a tile only points to one of the shared pieces (see
+ * Piece::get) so copying one copies a pointer and never allocates
+ */
 
 class Tile {
 	private:
-		std::shared_ptr<Piece> occupant; // the occupying piece
+		const Piece* occupant; // the occupying piece, NULL if empty
 	public:
 		Tile(); // default constructor
-		Tile(Piece* p); // parameterized constructor
-		Tile(const Tile& t); // copy constructor
-		~Tile(); // destructor
+		Tile(const Piece* p); // parameterized constructor
 
 		// member methods
 		void reset();
 
 		// accessor methods
-		Piece& getPiece();
+		const Piece& getPiece() const;
 
 		// operator methods
-		Tile& operator=(const Tile&);
-		Tile& operator=(Piece*);
+		Tile& operator=(const Piece*);
 		operator bool() const;
-		friend std::ostream& operator<<(std::ostream&, Tile&);
+		friend std::ostream& operator<<(std::ostream&, const Tile&);
 };
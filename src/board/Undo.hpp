@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Undo record declaration, filled by Board::makeMove with everything a move
+ * destroys so Board::unmakeMove can restore the position exactly. It is a
+ * plain record so search can keep one per ply on the stack
+ */
+
+struct Undo {
+	unsigned int moved; // type of the moving piece
+	unsigned int captured; // type of the captured piece, Piece::TYPES if none
+	unsigned int castling; // castling rights before the move
+	uint64_t key; // Zobrist key before the move
+	unsigned int halfmoves; // halfmove clock before the move
+	bool promoted; // whether a pawn became a queen
+	bool castled; // whether the king swapped with its rook
+};
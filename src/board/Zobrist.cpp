@@ -0,0 +1,37 @@
+#include "Zobrist.hpp"
+
+// Zobrist key definitions
+
+namespace Zobrist {
+	uint64_t pieces[2][6][64];
+	uint64_t castling[16];
+	uint64_t side;
+
+	/**
+	 * the keys are filled once before main() runs from a fixed seed, so keys
+	 * are stable from run to run
+	 */
+	struct Init {
+		uint64_t seed;
+
+		// xorshift64* pseudo random generator
+		uint64_t next() {
+			seed ^= seed >> 12; seed ^= seed << 25; seed ^= seed >> 27;
+			return seed * 2685821657736338717ULL;
+		}
+
+		Init() : seed(1070372ULL) {
+			for (unsigned int c = 0; c < 2; c++) {
+				for (unsigned int t = 0; t < 6; t++) {
+					for (unsigned int s = 0; s < 64; s++) {
+						pieces[c][t][s] = next();
+					}
+				}
+			}
+			// no castling rights leaves the key untouched
+			castling[0] = 0;
+			for (unsigned int i = 1; i < 16; i++) { castling[i] = next(); }
+			side = next();
+		}
+	} init;
+}
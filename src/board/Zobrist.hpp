@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Zobrist keys, every piece on every square, every set of castling rights and
+ * the side to move has its own random 64-bit key. A position's key is the XOR
+ * of the keys of everything in it, so moves update it incrementally
+ */
+
+namespace Zobrist {
+	// one key per color, piece type and square
+	extern uint64_t pieces[2][6][64];
+	// one key per combination of the four castling rights
+	extern uint64_t castling[16];
+	// toggled on every move, as white and black alternate
+	extern uint64_t side;
+}
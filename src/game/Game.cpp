@@ -20,31 +20,28 @@ void Game::play() {
 		// white move
 		getBoard()->printBoard(); // print current board
 		// check if checkmate, check, draw, or stalemate occurred
-		if (getBoard()->determineCheckmate(getPlayerWhite().getColor())) {
-			setGameState(3); break;
-		}
-		if (getBoard()->determineDraw()) { setGameState(2); break; }
-		if (getBoard()->determineStalemate(getPlayerWhite().getColor())) {
-			setGameState(1); break;
-		}
-		if (getBoard()->determineCheck(getPlayerWhite().getColor())) {
-			std::cout << "\nWhite is in check!\n";
-		}
+		const Status &white =
+			getBoard()->getStatus(getPlayerWhite().getColor());
+		if (white.checkmate) { setGameState(3); break; }
+		if (white.draw) { setGameState(2); break; }
+		if (white.stalemate) { setGameState(1); break; }
+		if (white.check) { std::cout << "\nWhite is in check!\n"; }
 		whiteMove(); // otherwise make a move
+		if (getGameState()) { break; } // if white quit
 		// black move
 		getBoard()->printBoard();
-		if (getBoard()->determineCheckmate(getPlayerBlack().getColor())) {
-			setGameState(4); break;
-		}
-		if (getBoard()->determineStalemate(getPlayerBlack().getColor())) {
-			setGameState(1); break;
-		}
-		if (getBoard()->determineDraw()) { setGameState(2); break; }
-		if (getBoard()->determineCheck(getPlayerBlack().getColor())) {
-			std::cout << "\nBlack is in check!\n";
-		}
+		const Status &black =
+			getBoard()->getStatus(getPlayerBlack().getColor());
+		if (black.checkmate) { setGameState(4); break; }
+		if (black.stalemate) { setGameState(1); break; }
+		if (black.draw) { setGameState(2); break; }
+		if (black.check) { std::cout << "\nBlack is in check!\n"; }
 		blackMove();
+		if (getGameState()) { break; } // if black quit
 	}
+	// stop anything the players still have running, such as pondering
+	getPlayerWhite().endGame();
+	getPlayerBlack().endGame();
 	switch(getGameState()) { // if game is over
 		case 1: std::cout << "\nStalemate.\n\n"; break;
 		case 2: std::cout << "\nDraw.\n\n"; break;
@@ -58,6 +55,8 @@ inline void Game::whiteMove() {
 	std::cout << "\nTurn " << moveCount << ", White to move...\n";
 	// get a move as prompted
 	Move m = getPlayerWhite().promptMove();
+	// a player who quits makes no move, and the game ends
+	if (getPlayerWhite().hasQuit()) { setGameState(5); return; }
 	std::cout << "\nWhite has moved " << m << "\n";
 	makeMove(m); // make the move
 	moveCount++;
@@ -68,6 +67,7 @@ inline void Game::blackMove() {
 	std::cout << "\nTurn " << moveCount << ", Black to move...\n";
 	// get a move as prompted or AI generated
 	Move m = getPlayerBlack().promptMove();
+	if (getPlayerBlack().hasQuit()) { setGameState(5); return; }
 	std::cout << "\nBlack has moved " << m << "\n";
 	makeMove(m); // make the move
 	moveCount++;
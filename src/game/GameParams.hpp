@@ -14,11 +14,51 @@ namespace GameParams {
 	const static int C3 = 3; // for pawn rank value
 
 	/**
-	 * move buffer for AI, prevents move reduplication within the last few
-	 * moves. This should be relatively small perhaps ideally in the single
-	 * digits. Much larger and the AI will tend to forfeit early
+	 * transposition table size in megabytes for each AI player, may be
+	 * overridden with --hash on the command line. Larger tables remember more
+	 * positions between moves at the cost of memory
 	 */
-	const static unsigned int BUFFER_SIZE = 3;
+	const static unsigned int HASH_SIZE = 16;
+
+	/**
+	 * selective search, each technique trades a little accuracy for searching
+	 * deeper in the same time and may be switched off on its own. Null move
+	 * pruning gives the opponent a free move, and should a search reduced by
+	 * NULL_MOVE_R plies still fail high the position is pruned. Late move
+	 * reductions search quiet moves ordered after the first LMR_MOVES one ply
+	 * shallower from LMR_DEPTH on. Futility pruning skips quiet moves within
+	 * FUTILITY_DEPTH plies of the leaves when the evaluation trails alpha by
+	 * more than FUTILITY_MARGIN per ply. Mate distance pruning cuts lines which
+	 * cannot mate sooner than a mate already found
+	 */
+	const static bool NULL_MOVE = true;
+	const static unsigned int NULL_MOVE_R = 2;
+	const static bool LMR = true;
+	const static unsigned int LMR_MOVES = 3;
+	const static unsigned int LMR_DEPTH = 3;
+	const static bool FUTILITY = true;
+	const static unsigned int FUTILITY_DEPTH = 2;
+	const static int FUTILITY_MARGIN = 36;
+	const static bool MATE_DISTANCE = true;
+
+	/**
+	 * time management for an AI on the clock. Each move is given an even share
+	 * of the time left over the moves to the next time control (MOVES_TO_GO if
+	 * unknown) plus the increment, after which no further iteration is begun.
+	 * An iteration already under way may run on to TIME_HARD times that share
+	 * before it is stopped, but never past half the time left. TIME_MARGIN is
+	 * held back for the time lost outside the search
+	 */
+	const static unsigned int MOVES_TO_GO = 30;
+	const static unsigned int TIME_HARD = 3;
+	const static unsigned int TIME_MARGIN = 50; // ms
+
+	/**
+	 * pondering, in games against a human the AI searches on the human's time
+	 * the position after the reply it expects. Should the human reply so, the
+	 * search is well under way when the AI's turn comes
+	 */
+	const static bool PONDER = true;
 
 	/**
 	 * piece values, generally keep this the way it is, there's no real need to
@@ -30,6 +70,8 @@ namespace GameParams {
 	const static unsigned int R_VAL = 5; // for rooks
 	const static unsigned int Q_VAL = 9; // for queens
 	const static unsigned int K_VAL = 100; // for kings
+	// the same values indexed by piece type (pawn, knight, ..., king)
+	const static int VALUES[] = { P_VAL, N_VAL, B_VAL, R_VAL, Q_VAL, K_VAL };
 
 	/**
 	 * game state values, generally keep this the way it is, there's no real
@@ -54,13 +96,27 @@ namespace GameParams {
 	const static int C1 = 12;
 	const static int C2 = 1;
 	const static int C3 = 3;
-	const static unsigned int BUFFER_SIZE = 3;
+	const static unsigned int HASH_SIZE = 16;
+	const static bool NULL_MOVE = true;
+	const static unsigned int NULL_MOVE_R = 2;
+	const static bool LMR = true;
+	const static unsigned int LMR_MOVES = 3;
+	const static unsigned int LMR_DEPTH = 3;
+	const static bool FUTILITY = true;
+	const static unsigned int FUTILITY_DEPTH = 2;
+	const static int FUTILITY_MARGIN = 36;
+	const static bool MATE_DISTANCE = true;
+	const static unsigned int MOVES_TO_GO = 30;
+	const static unsigned int TIME_HARD = 3;
+	const static unsigned int TIME_MARGIN = 50;
+	const static bool PONDER = true;
 	const static unsigned int P_VAL = 1;
 	const static unsigned int N_VAL = 3;
 	const static unsigned int B_VAL = 3;
 	const static unsigned int R_VAL = 5;
 	const static unsigned int Q_VAL = 9;
 	const static unsigned int K_VAL = 100;
+	const static int VALUES[] = { P_VAL, N_VAL, B_VAL, R_VAL, Q_VAL, K_VAL };
 	const static int CHECKMATE = (CHECK * ((C1*103) + (C2*215) + (C3*48))) + 1;
 	const static int STALEMATE = 0;
 	const static int DRAW = 0;
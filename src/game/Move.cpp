@@ -2,9 +2,6 @@
 
 // Move class definition, defines how moves are encapsulated and accessed
 
-// Move default constructor
-Move::Move() {}
-
 /**
  * Move parameterized constructor
  * @param oC, oR - the origin of the move (col, row)
@@ -25,26 +22,20 @@ std::string Move::stateMove() {
 	return toReturn.str();
 }
 
-// accessor methods
-unsigned int Move::getOrigR() { return origR; }
-unsigned int Move::getOrigC() { return origC; }
-unsigned int Move::getDestR() { return destR; }
-unsigned int Move::getDestC() { return destC; }
-
 // operator methods
-bool Move::operator==(Move &m) {
+bool Move::operator==(const Move &m) const {
 	// determine if origin and destination are equivalent
 	bool sameOrig = (getOrigR() == m.getOrigR() && getOrigC() == m.getOrigC());
 	bool sameDest = (getDestR() == m.getDestR() && getDestC() == m.getDestC());
 	return sameOrig && sameDest;
 }
 
-bool Move::operator<=(Move &m) {
+bool Move::operator<=(const Move &m) const {
 	// determine if origin is equivalent
 	return (getOrigR() == m.getOrigR() && getOrigC() == m.getOrigC());
 }
 
-bool Move::operator>=(Move &m) {
+bool Move::operator>=(const Move &m) const {
 	// determine if destination is equivalent
 	return (getDestR() == m.getDestR() && getDestC() == m.getDestC());
 }
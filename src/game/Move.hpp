@@ -5,25 +5,27 @@
 
 class Move {
 	private:
-		unsigned int origC, origR; // origin of move
-		unsigned int destC, destR; // destination of move
+		// coordinates fit in a byte each, keeping a move to four bytes
+		unsigned char origC, origR; // origin of move
+		unsigned char destC, destR; // destination of move
 	public:
-		Move(); // default constructor
+		// default constructor, inline so empty move lists cost nothing
+		Move() {}
 		// parameterized constructor
 		Move(unsigned int, unsigned int, unsigned int, unsigned int);
 
 		// member methods
 		std::string stateMove();
 
-		// accessor methods
-		unsigned int getOrigR();
-		unsigned int getOrigC();
-		unsigned int getDestR();
-		unsigned int getDestC();
+		// accessor methods, defined here so they inline into move generation
+		unsigned int getOrigR() const { return origR; }
+		unsigned int getOrigC() const { return origC; }
+		unsigned int getDestR() const { return destR; }
+		unsigned int getDestC() const { return destC; }
 
 		// operator methods
-		bool operator==(Move&);
-		bool operator>=(Move&);
-		bool operator<=(Move&);
+		bool operator==(const Move&) const;
+		bool operator>=(const Move&) const;
+		bool operator<=(const Move&) const;
 		friend std::ostream& operator<<(std::ostream&, Move&);
 };
@@ -0,0 +1,42 @@
+#pragma once
+#include "Move.hpp"
+
+/**
+ * MoveList class declaration, a list of moves held in fixed storage inside the
+ * object itself. Move generation appends to a list living on the caller's
+ * stack, so generating moves never allocates. No position has been found with
+ * more than 218 legal moves, so the capacity is ample
+ */
+
+class MoveList {
+	public:
+		const static unsigned int CAPACITY = 256;
+	private:
+		Move moves[CAPACITY]; // the moves themselves
+		unsigned int count; // how many are in use
+	public:
+		MoveList() : count(0) {} // constructor
+
+		// member methods, named as std::vector's for familiarity
+		void push_back(const Move &m) { moves[count++] = m; }
+		void clear() { count = 0; }
+		unsigned int size() const { return count; }
+
+		/**
+		 * method to remove a move, keeping the order of the rest
+		 * @param i - the index of the move
+		 */
+		void erase(unsigned int i) {
+			for (count--; i < count; i++) { moves[i] = moves[i+1]; }
+		}
+
+		// iterators, for use with <algorithm>
+		Move* begin() { return moves; }
+		Move* end() { return moves + count; }
+		const Move* begin() const { return moves; }
+		const Move* end() const { return moves + count; }
+
+		// operator methods
+		Move& operator[](unsigned int i) { return moves[i]; }
+		const Move& operator[](unsigned int i) const { return moves[i]; }
+};
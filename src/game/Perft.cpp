@@ -0,0 +1,113 @@
+#include "Perft.hpp"
+#include <chrono>
+#include <thread>
+
+// Perft class definition
+
+/**
+ * Perft class constructor
+ * @param b - the board to count from
+ * @param c - the color to move
+ * @param d - the depth to count to, at least one
+ * @param t - the number of counting threads
+ * @param h - the hash table size in megabytes, zero for none
+ */
+Perft::Perft(Board* b, bool c, unsigned int d, unsigned int t, unsigned int h)
+	: root(*b), side(c), depth(d), threads((t > 0) ? t : 1),
+		table((h > 0) ? ((size_t)h << 20) / sizeof(Entry) : 0), next(0) {
+	for (size_t i = 0; i < table.size(); i++) {
+		table[i].check.store(0); table[i].count.store(0);
+	}
+}
+
+/**
+ * method to count and print the leaf nodes below each root move (divide), then
+ * the total and the speed. Root moves are handed out to the threads one at a
+ * time, each thread counting on its own copy of the board
+ */
+void Perft::run() {
+	moveList.clear();
+	root.getAllMoves(!side, moveList);
+	counts.assign(moveList.size(), 0);
+	std::chrono::steady_clock::time_point start;
+	start = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < threads; i++) {
+		workers.push_back(std::thread(&Perft::worker, this));
+	}
+	worker(); // this thread counts too
+	for (unsigned int i = 0; i < workers.size(); i++) { workers[i].join(); }
+	std::chrono::duration<double> taken;
+	taken = std::chrono::steady_clock::now() - start;
+	uint64_t total = 0;
+	for (unsigned int i = 0; i < moveList.size(); i++) {
+		std::cout << moveList[i] << ": " << counts[i] << "\n";
+		total += counts[i];
+	}
+	std::cout << "\nMoves: " << moveList.size() << "\n";
+	std::cout << "Nodes: " << total << "\n";
+	std::cout << "Time: " << (uint64_t)(taken.count() * 1000) << "ms\n";
+	double nps = (taken.count() > 0) ? total / taken.count() : 0;
+	std::cout << "Nodes per second: " << (uint64_t)nps << "\n";
+}
+
+// method run by each thread, counts root moves until there are none left
+void Perft::worker() {
+	Board board(root);
+	while (true) {
+		unsigned int i = next.fetch_add(1);
+		if (i >= moveList.size()) { break; }
+		Undo u;
+		board.makeMove(moveList[i], u);
+		counts[i] = (depth > 1) ? count(board, depth-1, !side) : 1;
+		board.unmakeMove(moveList[i], u);
+	}
+}
+
+/**
+ * method to count leaf nodes recursively
+ * @param b - the board to count on
+ * @param d - the depth left, at least one
+ * @param c - the color to move
+ * @return - the number of leaf nodes
+ */
+uint64_t Perft::count(Board &b, unsigned int d, bool c) {
+	// look for a count of this subtree from another move order
+	uint64_t key = hashKey(b, d);
+	Entry* e = (table.size() > 0) ? &table[key % table.size()] : NULL;
+	if (e) {
+		uint64_t n = e->count.load(std::memory_order_relaxed);
+		if ((e->check.load(std::memory_order_relaxed) ^ n) == key) {
+			return n;
+		}
+	}
+	MoveList m;
+	b.getAllMoves(!c, m);
+	// bulk count: the last ply's leaves are just the number of legal moves
+	uint64_t n = m.size();
+	if (d > 1) {
+		n = 0;
+		for (unsigned int i = 0; i < m.size(); i++) {
+			Undo u;
+			b.makeMove(m[i], u);
+			n += count(b, d-1, !c);
+			b.unmakeMove(m[i], u);
+		}
+	}
+	if (e) {
+		e->check.store(key ^ n, std::memory_order_relaxed);
+		e->count.store(n, std::memory_order_relaxed);
+	}
+	return n;
+}
+
+/**
+ * method to find the hash key of a subtree, the same position counted to a
+ * different depth is a different subtree
+ * @param b - the board
+ * @param d - the depth left
+ * @return - the key
+ */
+inline uint64_t Perft::hashKey(Board &b, unsigned int d) {
+	return b.getKey() ^ (d * 0x9E3779B97F4A7C15ULL);
+}
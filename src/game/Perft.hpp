@@ -0,0 +1,38 @@
+#pragma once
+#include "../board/Board.hpp"
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * Perft class declaration, counts the leaf nodes of the legal move tree to a
+ * fixed depth. The counts check move generation and the legality filter for
+ * correctness and the time taken benchmarks their speed
+ */
+
+class Perft {
+	private:
+		// a hash entry is the key XOR the count, and the count
+		struct Entry {
+			std::atomic<uint64_t> check;
+			std::atomic<uint64_t> count;
+		};
+
+		Board root; // the position to count from
+		bool side; // the color to move at the root
+		unsigned int depth; // the depth to count to
+		unsigned int threads; // number of counting threads
+		std::vector<Entry> table; // subtree counts, empty if unused
+		MoveList moveList; // the root moves
+		std::vector<uint64_t> counts; // leaf count per root move
+		std::atomic<unsigned int> next; // next root move to hand out
+
+		// private member methods
+		void worker();
+		uint64_t count(Board&, unsigned int, bool);
+		uint64_t hashKey(Board&, unsigned int);
+	public:
+		Perft(Board*, bool, unsigned int, unsigned int, unsigned int);
+
+		// public member methods
+		void run();
+};
@@ -0,0 +1,228 @@
+#include "Uci.hpp"
+
+// Uci class definition
+
+/**
+ * Uci class constructor
+ * @param h - the transposition table size in megabytes
+ * @param t - the number of search threads
+ */
+Uci::Uci(unsigned int h, unsigned int t)
+	: side(WHITE), hash(h), threads(t), stopping(false), infinite(false) {}
+
+/**
+ * main loop, answers commands one line at a time until "quit" or the end of
+ * input. Commands which change what is searched stop any search first
+ */
+void Uci::run() {
+	std::string line;
+	while (std::getline(std::cin, line)) {
+		std::istringstream in(line);
+		std::string command;
+		in >> command;
+		if (command == "uci") {
+			std::ostringstream out;
+			out << "id name chess-engine\n";
+			out << "id author stratzilla\n";
+			out << "option name Hash type spin default " << hash;
+			out << " min 1 max 4096\n";
+			out << "option name Threads type spin default " << threads;
+			out << " min 1 max 64\n";
+			out << "uciok\n";
+			send(out.str());
+		} else if (command == "isready") {
+			send("readyok\n");
+		} else if (command == "ucinewgame") {
+			stopSearch();
+			// forget the last game, the AIs are made again on the next search
+			engines[WHITE].reset(); engines[BLACK].reset();
+		} else if (command == "position") {
+			stopSearch();
+			position(in);
+		} else if (command == "go") {
+			stopSearch();
+			go(in);
+		} else if (command == "stop") {
+			stopSearch();
+		} else if (command == "setoption") {
+			stopSearch();
+			setOption(in);
+		} else if (command == "quit") {
+			break;
+		}
+	}
+	stopSearch();
+}
+
+/**
+ * method to set up the position to search, "startpos" or "fen <fields>" then
+ * optionally "moves" and the moves played from there. The moves are played
+ * out on a scratch board, and should any be illegal the previous position is
+ * kept whole rather than left part way through the list
+ * @param in - the rest of the command
+ */
+void Uci::position(std::istringstream &in) {
+	std::string token;
+	in >> token;
+	Board b;
+	bool s = WHITE;
+	if (token == "fen") {
+		std::string fen;
+		while (in >> token && token != "moves") { fen += token + " "; }
+		if (!b.loadFen(fen, s)) { send("info string invalid fen\n"); return; }
+	} else if (token == "startpos") {
+		in >> token;
+	} else {
+		return;
+	}
+	if (token == "moves") {
+		while (in >> token) {
+			Move m;
+			if (!parseMove(b, s, token, m)) {
+				send("info string illegal move " + token + "\n");
+				return;
+			}
+			b.movePiece(m);
+			s = !s;
+		}
+	}
+	board = b;
+	side = s;
+}
+
+/**
+ * method to start a search of the position, limited by any of "depth",
+ * "nodes", "movetime", or the clock ("wtime", "btime", "winc", "binc",
+ * "movestogo"), or else "infinite" until "stop"
+ * @param in - the rest of the command
+ */
+void Uci::go(std::istringstream &in) {
+	unsigned int depth = 0, nodes = 0, moveTime = 0;
+	unsigned int time[2] = {0, 0}, inc[2] = {0, 0}, movesToGo = 0;
+	infinite = false;
+	std::string token;
+	while (in >> token) {
+		if (token == "infinite") { infinite = true; continue; }
+		long long v;
+		// a clock may have run below zero by the time the command is read
+		if (!(in >> v)) { break; }
+		unsigned int value = (v > 0) ? (unsigned int)v : 0;
+		if (token == "depth") { depth = value; }
+		else if (token == "nodes") { nodes = value; }
+		else if (token == "movetime") { moveTime = value; }
+		else if (token == "wtime") { time[WHITE] = value; }
+		else if (token == "btime") { time[BLACK] = value; }
+		else if (token == "winc") { inc[WHITE] = value; }
+		else if (token == "binc") { inc[BLACK] = value; }
+		else if (token == "movestogo") { movesToGo = value; }
+	}
+	if (infinite) { depth = 0; nodes = 0; moveTime = 0; time[side] = 0; }
+	// with no move to make there is nothing to search
+	if (board.getStatus(side).moves.size() == 0) {
+		send("bestmove 0000\n"); return;
+	}
+	if (!engines[side]) {
+		// the depth is set for each search
+		engines[side] = std::make_shared<Computer>(side, 1, hash, threads);
+		engines[side]->setUci(true);
+		engines[side]->setBoard(&board);
+	}
+	// the AI shares out its own time from the clock
+	engines[side]->setLimits(depth, nodes, moveTime);
+	engines[side]->setClock(time[side], inc[side], movesToGo);
+	engines[side]->setStopped(false);
+	stopping.store(false);
+	searcher = std::thread(&Uci::search, this, engines[side]);
+}
+
+/**
+ * method to change an option, "name <id> value <x>", see "uci" for options
+ * @param in - the rest of the command
+ */
+void Uci::setOption(std::istringstream &in) {
+	std::string token, name, value;
+	in >> token; // "name"
+	while (in >> token && token != "value") {
+		name += (name.empty() ? "" : " ") + token;
+	}
+	in >> value;
+	int v = atoi(value.c_str());
+	if (v < 1) { return; }
+	if (name == "Hash") {
+		hash = v;
+	} else if (name == "Threads") {
+		threads = v;
+	} else {
+		return;
+	}
+	// the AIs are made again with the option on the next search
+	engines[WHITE].reset(); engines[BLACK].reset();
+}
+
+/**
+ * method run by the search thread, searches and reports the move found
+ * @param engine - the AI to move, which reports its progress as it searches
+ */
+void Uci::search(std::shared_ptr<Computer> engine) {
+	Move m = engine->promptMove();
+	// an infinite search must not report before it is told to stop
+	while (infinite && !stopping.load()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	std::vector<Move> pv = engine->getPrincipalVariation();
+	std::ostringstream out;
+	out << "bestmove " << board.toUci(m);
+	if (pv.size() > 1) {
+		Board b(board);
+		b.movePiece(m);
+		out << " ponder " << b.toUci(pv[1]);
+	}
+	out << "\n";
+	send(out.str());
+}
+
+// method to stop the search if there is one, returning once it has reported
+void Uci::stopSearch() {
+	if (!searcher.joinable()) { return; }
+	stopping.store(true);
+	engines[side]->setStopped(true);
+	searcher.join();
+}
+
+/**
+ * method to read a move in coordinate notation, either the king moving two
+ * tiles when castling as Board::toUci writes it, or the king moving onto its
+ * own rook as the engine holds it. Promotion is always to a queen, so any
+ * promotion piece given is ignored
+ * @param b - the position the move is made in
+ * @param toMove - the color to move
+ * @param s - the move, e.g. "e2e4"
+ * @param m - set to the move
+ * @return - whether the move is legal in the position
+ */
+bool Uci::parseMove(Board &b, bool toMove, const std::string &s, Move &m) {
+	if (s.size() != 4 && s.size() != 5) { return false; }
+	unsigned int oc = s[0] - 'a', orow = s[1] - '1';
+	unsigned int dc = s[2] - 'a', drow = s[3] - '1';
+	if (oc > 7 || orow > 7 || dc > 7 || drow > 7) { return false; }
+	Move wanted(oc, orow, dc, drow);
+	// a king never otherwise moves two tiles along its row
+	bool king = b.getType(toMove, Bitboards::index(oc, orow)) == Piece::KING;
+	if (king && orow == drow && (dc == oc + 2 || dc + 2 == oc)) {
+		wanted = Move(oc, orow, (dc > oc) ? oc + 3 : oc - 4, drow);
+	}
+	const MoveList &moveList = b.getStatus(toMove).moves;
+	for (unsigned int i = 0; i < moveList.size(); i++) {
+		if (moveList[i] == wanted) { m = wanted; return true; }
+	}
+	return false;
+}
+
+/**
+ * method to write to standard output, the search thread writes info lines as
+ * this one answers commands, so each message is one write to keep them whole
+ * @param s - the message, ending in a newline
+ */
+void Uci::send(const std::string &s) {
+	std::cout << s << std::flush;
+}
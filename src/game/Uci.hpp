@@ -0,0 +1,43 @@
+#pragma once
+#include "../player/Computer.hpp"
+#include <atomic>
+#include <thread>
+
+/**
+ * Uci class declaration, plays the engine through the Universal Chess
+ * Interface on standard input and output so other programs may drive it. The
+ * search runs on its own thread, leaving this one free to answer "isready"
+ * and "stop" at once
+ */
+
+class Uci {
+	private:
+		const static bool WHITE = true, BLACK = false;
+
+		Board board; // the position to search
+		bool side; // the color to move
+		unsigned int hash; // transposition table size in megabytes
+		unsigned int threads; // number of search threads
+		/**
+		 * one AI per color as the AI plays a fixed color, created on first
+		 * search so that options given beforehand take effect
+		 */
+		std::shared_ptr<Computer> engines[2];
+		std::thread searcher; // runs the search, joinable while searching
+		std::atomic<bool> stopping; // whether "stop" has been sent
+		bool infinite; // whether to hold the result until "stop"
+
+		// private member methods
+		void position(std::istringstream&);
+		void go(std::istringstream&);
+		void setOption(std::istringstream&);
+		void search(std::shared_ptr<Computer>);
+		void stopSearch();
+		bool parseMove(Board&, bool, const std::string&, Move&);
+		void send(const std::string&);
+	public:
+		Uci(unsigned int, unsigned int); // constructor
+
+		// public member methods
+		void run();
+};
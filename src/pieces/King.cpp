@@ -10,23 +10,17 @@ King::King(bool c)
 	: Piece(c, GameParams::K_VAL, 'K') {} // chain into base constructor
 
 /**
- * explicit copy constructor
- * @return - a copy of this object
- */
-std::shared_ptr<Piece> King::clone() const {
-	return std::shared_ptr<Piece>(new King(*this));
-}
-
-/**
- * method to determine which moves this piece may make, creates a collection of
- * valid moves the piece can make
+ * method to determine which moves this piece may make, appends the valid moves
+ * the piece can make to a collection
  * @param b - the board the piece is on
  * @param c - the columnar coordinate of the piece
  * @param r - the row coordinate of the piece
- * @return - a collection of moves this piece may make
+ * @param moveList - the collection of moves to append to
+ * @param mask - the tiles the moves may end on, others are skipped
  */
-std::vector<Move> King::getMoves(Board* b, unsigned int c, unsigned int r) {
-	std::vector<Move> moveList;
+void King::getMoves(Board* b, unsigned int c, unsigned int r,
+					MoveList &moveList, Bitboard mask) const {
+	unsigned int start = moveList.size(); // this king's moves start here
 	for (unsigned int j = 0; j < MOVE_NUM; j++) {
 		int x = c, y = r; // signed as it may be OOB later
 		switch(j) {
@@ -41,10 +35,11 @@ std::vector<Move> King::getMoves(Board* b, unsigned int c, unsigned int r) {
 		}
 		// determine if the move is valid
 		if (checkInBounds(x, y)) { // if valid board position
-			Tile possibleMove = (*b)(x, y);
-			if (possibleMove) { // if tile is occupied
+			Bitboard possibleMove = Bitboards::square(x, y);
+			if (!(mask & possibleMove)) { continue; } // if not asked for
+			if (b->getOccupied() & possibleMove) { // if tile is occupied
 				// if occupying piece is opposing color
-				if (possibleMove.getPiece().getColor() != color) {
+				if (!(b->getColorPieces(color) & possibleMove)) {
 					// capturing the piece is a valid move
 					moveList.push_back(Move(c, r, x, y));
 				}
@@ -56,103 +51,85 @@ std::vector<Move> King::getMoves(Board* b, unsigned int c, unsigned int r) {
 	}
 	/**
 	 * castling specific code separated as it does not follow normal movement
-	 * pattern
+	 * pattern. The board keeps the castling rights, which only survive while
+	 * neither the king nor that rook has left home, so the king is known to be
+	 * on its first move at the expected position
 	 */
-	bool checkWhitePos = (getColor() && c == 4 && r == 0); // valid W pos
-	bool checkBlackPos = (!getColor() && c == 4 && r == 7); // valid B pos
-	if (!getMoved() && (checkWhitePos || checkBlackPos)) { // if first move
-		for (unsigned int j = 0; j < CASTLE_MOVE; j++) {
-			/**
-			 * castling to the east requires a check of two positions between
-			 * king and rook, whereas castling to the west needs three position
-			 * checks
-			 */
-			for (unsigned int i = 1; i < ((j == 0) ? 4 : 5); ++i) {
-				Tile castle = (*b)(((j == 0) ? c+i : c-i), r);
-				// if path is not occupied but not at edge
-				if (!castle) {
-					continue; // continue as not edge tile
-				// if occupied but not at edge
-				} else if (i < ((j == 0) ? 3 : 4)) {
-					break; // there is some obstruction, castling not possible
-				}
-				// check if matching color
-				if (castle.getPiece().getColor() == getColor()) {
-					// check if rook
-					if (castle.getPiece().getValue() == GameParams::R_VAL) {
-						// only if the rook also has not moved
-						if (!castle.getPiece().getMoved()) {
-							// if unmoved rook of same color, valid castle
-							Move castleMove(c, r, (j == 0) ? c+i : c-i, r);
-							moveList.push_back(castleMove);
-						}
-					}
-				}
-			}
+	for (unsigned int j = 0; j < CASTLE_MOVE; j++) {
+		if (!b->canCastle(getColor(), j == 0)) { continue; }
+		/**
+		 * castling to the east requires a check of two positions between
+		 * king and rook, whereas castling to the west needs three position
+		 * checks
+		 */
+		Bitboard path = 0;
+		for (unsigned int i = 1; i < ((j == 0) ? 3 : 4); ++i) {
+			path |= Bitboards::square(((j == 0) ? c+i : c-i), r);
+		}
+		// if path is not occupied, castle onto the unmoved rook
+		unsigned int x = (j == 0) ? c+3 : c-4;
+		if (!(b->getOccupied() & path) && (mask & Bitboards::square(x, r))) {
+			moveList.push_back(Move(c, r, x, r));
 		}
 	}
-	// remove invalid moves
-	removeSurroundingKings(b, moveList);
-	removeCheckedMoves(b, moveList);
-	return moveList;
+	// remove moves onto attacked tiles, including next to the other king
+	removeCheckedMoves(b, moveList, start);
 }
 
+
 /**
- * method to remove moves which put king next to king
- * @param b - the board the king is on
- * @param m - movelist to remove from
+ * method to count the moves this piece may make without building them, steps
+ * onto attacked tiles are left out as getMoves leaves them out
+ * @param b - the board the piece is on
+ * @param c - the columnar coordinate of the piece
+ * @param r - the row coordinate of the piece
+ * @return - the number of moves getMoves would find
  */
-inline void King::removeSurroundingKings(Board* b, std::vector<Move> &m) {
-	std::vector<int> indexes;
-	for (unsigned int j = 0; j < m.size(); j++) {
-		for (unsigned int i = 0; i < MOVE_NUM; i++) {
-			int x = m[j].getDestC(), y = m[j].getDestR();
-			switch(i) {
-				case 0: y += MIN_MOVE; break; // north
-				case 1: x += MIN_MOVE; y += MIN_MOVE; break; // north-east
-				case 2: x += MIN_MOVE; break; // east
-				case 3: x += MIN_MOVE; y -= MIN_MOVE; break; // south-east
-				case 4: y -= MIN_MOVE; break; // south
-				case 5: x -= MIN_MOVE; y -= MIN_MOVE; break; // south-west
-				case 6: x -= MIN_MOVE; break; // west
-				case 7: x -= MIN_MOVE; y += MIN_MOVE; break; // north-west
-			}
-			// check if move is in bounds and has a piece
-			if (checkInBounds(x, y) && (*b)(x, y)) {
-				// if occupying piece is opposing color
-				if ((*b)(x, y).getPiece().getColor() != getColor()) {
-					// if piece is king
-					if ((*b)(x, y).getPiece().getValue() == GameParams::K_VAL) {
-						indexes.insert(indexes.begin(), j);
-					}
-				}
-			}
+unsigned int King::countMoves(Board* b, unsigned int c,
+								unsigned int r) const {
+	unsigned int s = Bitboards::index(c, r);
+	Bitboard targets = Bitboards::kingAttacks(s) & ~b->getColorPieces(color);
+	// the king no longer blocks the rays it steps along
+	Bitboard occ = b->getOccupied() & ~Bitboards::bit(s);
+	unsigned int count = 0;
+	while (targets) {
+		if (!b->isSquareAttacked(Bitboards::popLsb(targets), !color, occ)) {
+			count++;
 		}
 	}
-	for (unsigned int i = 0; i < indexes.size(); i++) {
-		m.erase(m.begin() + indexes[i]);
+	// castling onto an unmoved rook, which stays on the king's tile
+	for (unsigned int j = 0; j < CASTLE_MOVE; j++) {
+		if (!b->canCastle(getColor(), j == 0)) { continue; }
+		Bitboard path = 0;
+		for (unsigned int i = 1; i < ((j == 0) ? 3 : 4); ++i) {
+			path |= Bitboards::square(((j == 0) ? c+i : c-i), r);
+		}
+		if (b->getOccupied() & path) { continue; }
+		unsigned int rook = Bitboards::index((j == 0) ? c+3 : c-4, r);
+		if (!b->isSquareAttacked(rook, !color)) { count++; }
 	}
-	indexes.clear();
+	return count;
 }
 
 /**
- * method to remove moves which would put king in check
+ * method to remove moves which would put king in check, the king is in check
+ * after a move exactly when its destination is attacked with the king gone
+ * from its origin (a castling swap leaves the rook there instead)
  * @param b - the board the king is on
  * @param m - movelist to remove moves from
+ * @param start - the index of the first of this king's moves in the list
  */
-inline void King::removeCheckedMoves(Board* b, std::vector<Move> &m) {
-	std::vector<int> indexes;
-	for (unsigned int i = 0; i < m.size(); i++) {
-		// make move on a copy and check if in check
-		Board* copy = new Board(*b);
-		copy->movePiece(m[i]);
-		if (copy->determineCheck(getColor())) {
-			indexes.insert(indexes.begin(), i);
+inline void King::removeCheckedMoves(Board* b, MoveList &m,
+										unsigned int start) const {
+	for (unsigned int i = m.size(); i > start; i--) {
+		Move &move = m[i-1];
+		Bitboard orig = Bitboards::square(move.getOrigC(), move.getOrigR());
+		Bitboard dest = Bitboards::square(move.getDestC(), move.getDestR());
+		Bitboard occ = b->getOccupied();
+		if (!(b->getColorPieces(getColor()) & dest)) { occ &= ~orig; }
+		unsigned int s = Bitboards::lsb(dest);
+		if (b->isSquareAttacked(s, !getColor(), occ)) {
+			m.erase(i-1);
 		}
-		delete copy; // free up that memory
-	}
-	for (unsigned int i = 0; i < indexes.size(); i++) {
-		m.erase(m.begin() + indexes[i]);
 	}
-	indexes.clear();
 }
@@ -16,12 +16,12 @@ class King : public Piece {
 		const static unsigned int CASTLE_MOVE = 2;
 
 		// private member methods
-		void removeSurroundingKings(Board*, std::vector<Move>&);
-		void removeCheckedMoves(Board*, std::vector<Move>&);
+		void removeCheckedMoves(Board*, MoveList&, unsigned int) const;
 	public:
 		King(bool); // constructor
-		std::shared_ptr<Piece> clone() const; // copy constructor
 
 		// public member methods
-		std::vector<Move> getMoves(Board*, unsigned int, unsigned int);
+		void getMoves(Board*, unsigned int, unsigned int, MoveList&,
+						Bitboard) const;
+		unsigned int countMoves(Board*, unsigned int, unsigned int) const;
 };
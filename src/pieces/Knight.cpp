@@ -10,23 +10,16 @@ Knight::Knight(bool c)
 	: Piece(c, GameParams::N_VAL, 'N') {} // chain into base constructor
 
 /**
- * explicit copy constructor
- * @return - a copy of this object
- */
-std::shared_ptr<Piece> Knight::clone() const {
-	return std::shared_ptr<Piece>(new Knight(*this));
-}
-
-/**
- * method to determine which moves this piece may make, creates a collection of
- * valid moves the piece can make
+ * method to determine which moves this piece may make, appends the valid moves
+ * the piece can make to a collection
  * @param b - the board the piece is on
  * @param c - the columnar coordinate of the piece
  * @param r - the row coordinate of the piece
- * @return - a collection of moves this piece may make
+ * @param moveList - the collection of moves to append to
+ * @param mask - the tiles the moves may end on, others are skipped
  */
-std::vector<Move> Knight::getMoves(Board* b, unsigned int c, unsigned int r) {
-	std::vector<Move> moveList;
+void Knight::getMoves(Board* b, unsigned int c, unsigned int r,
+					MoveList &moveList, Bitboard mask) const {
 	for (unsigned int i = 0; i < MOVE_NUM; i++) {
 		int x = c, y = r; // signed as it may be OOB later
 		switch(i) {
@@ -41,10 +34,11 @@ std::vector<Move> Knight::getMoves(Board* b, unsigned int c, unsigned int r) {
 		}
 		// determine if the move is valid
 		if (checkInBounds(x, y)) { // if valid board position
-			Tile possibleMove = (*b)(x, y);
-			if (possibleMove) { // if tile is occupied
+			Bitboard possibleMove = Bitboards::square(x, y);
+			if (!(mask & possibleMove)) { continue; } // if not asked for
+			if (b->getOccupied() & possibleMove) { // if tile is occupied
 				// if occupying piece is opposing color
-				if (possibleMove.getPiece().getColor() != color) {
+				if (!(b->getColorPieces(color) & possibleMove)) {
 					// capturing the piece is a valid move
 					moveList.push_back(Move(c, r, x, y));
 				}
@@ -54,5 +48,18 @@ std::vector<Move> Knight::getMoves(Board* b, unsigned int c, unsigned int r) {
 			}
 		}
 	}
-	return moveList;
+}
+
+/**
+ * method to count the moves this piece may make without building them, the
+ * destinations are the attacked tiles not held by its own color
+ * @param b - the board the piece is on
+ * @param c - the columnar coordinate of the piece
+ * @param r - the row coordinate of the piece
+ * @return - the number of moves getMoves would find
+ */
+unsigned int Knight::countMoves(Board* b, unsigned int c,
+								unsigned int r) const {
+	Bitboard targets = Bitboards::knightAttacks(Bitboards::index(c, r));
+	return Bitboards::popCount(targets & ~b->getColorPieces(color));
 }
\ No newline at end of file
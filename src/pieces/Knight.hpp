@@ -14,8 +14,9 @@ class Knight : public Piece {
 		const static unsigned int MAX_MOVE = 2;
 	public:
 		Knight(bool); // constructor
-		std::shared_ptr<Piece> clone() const; // copy constructor
 
 		// member methods
-		std::vector<Move> getMoves(Board*, unsigned int, unsigned int);
+		void getMoves(Board*, unsigned int, unsigned int, MoveList&,
+						Bitboard) const;
+		unsigned int countMoves(Board*, unsigned int, unsigned int) const;
 };
@@ -10,28 +10,21 @@ Pawn::Pawn(bool c)
 	: Piece(c, GameParams::P_VAL, 'P') {} // chain into base constructor
 
 /**
- * explicit copy constructor
- * @return - a copy of this object
- */
-std::shared_ptr<Piece> Pawn::clone() const {
-	return std::shared_ptr<Piece>(new Pawn(*this));
-}
-
-/**
- * method to determine which moves this piece may make, creates a collection of
- * valid moves the piece can make
+ * method to determine which moves this piece may make, appends the valid moves
+ * the piece can make to a collection
  * @param b - the board the piece is on
  * @param c - the columnar coordinate of the piece
  * @param r - the row coordinate of the piece
- * @return - a collection of moves this piece may make
+ * @param moveList - the collection of moves to append to
+ * @param mask - the tiles the moves may end on, others are skipped
  */
-std::vector<Move> Pawn::getMoves(Board* b, unsigned int c, unsigned int r) {
-	std::vector<Move> moveList;
+void Pawn::getMoves(Board* b, unsigned int c, unsigned int r,
+					MoveList &moveList, Bitboard mask) const {
 	// an offset is needed: white moves north, black moves south
 	int offset = (getColor() == WHITE) ? 1 : -1;
 	for (unsigned int i = 0; i < MOVE_NUM; i++) {
-		// moving two spaces is only available for a pawn's first move
-		if (i == 1 && getMoved()) { continue; }
+		// moving two spaces is only available from a pawn's initial row
+		if (i == 1 && r != ((getColor() == WHITE) ? 1 : ROWS-2)) { continue; }
 		int x = c, y = r; // signed as it may be OOB later
 		switch(i) {
 			case 0: y += (MIN_MOVE * offset); break; // one space
@@ -41,16 +34,19 @@ std::vector<Move> Pawn::getMoves(Board* b, unsigned int c, unsigned int r) {
 		}
 		// determine if the move is valid
 		if (checkInBounds(x, y)) { // if valid board position
+			Bitboard possibleMove = Bitboards::square(x, y);
+			if (!(mask & possibleMove)) { continue; } // if not asked for
 			// cannot capture going forward
-			if ((i == 0 || i == 1) && (*b)(x, y)) { continue; }
-			// cannot jump over pieces
-			if (i == 1 && (*b)(x, y - (MIN_MOVE * offset))) {
+			if ((i == 0 || i == 1) && (b->getOccupied() & possibleMove)) {
 				continue;
 			}
-			Tile possibleMove = (*b)(x, y);
-			if ((i == 2 || i == 3) && possibleMove) { // if tile is occupied
+			// cannot jump over pieces
+			Bitboard between = Bitboards::square(x, y - (MIN_MOVE * offset));
+			if (i == 1 && (b->getOccupied() & between)) { continue; }
+			// if tile is occupied
+			if ((i == 2 || i == 3) && (b->getOccupied() & possibleMove)) {
 				// if occupying piece is opposing color
-				if (possibleMove.getPiece().getColor() != color) {
+				if (!(b->getColorPieces(color) & possibleMove)) {
 					// capturing the piece is a valid move
 					moveList.push_back(Move(c, r, x, y));
 				}
@@ -60,5 +56,34 @@ std::vector<Move> Pawn::getMoves(Board* b, unsigned int c, unsigned int r) {
 			}
 		}
 	}
-	return moveList;
+}
+
+/**
+ * method to count the moves this piece may make without building them, pushes
+ * need empty tiles and captures need opposing pieces
+ * @param b - the board the piece is on
+ * @param c - the columnar coordinate of the piece
+ * @param r - the row coordinate of the piece
+ * @return - the number of moves getMoves would find
+ */
+unsigned int Pawn::countMoves(Board* b, unsigned int c,
+								unsigned int r) const {
+	// an offset is needed: white moves north, black moves south
+	int offset = (getColor() == WHITE) ? COLS : -(int)COLS;
+	unsigned int s = Bitboards::index(c, r);
+	Bitboard empty = ~b->getOccupied();
+	// diagonal captures
+	Bitboard targets = Bitboards::pawnAttacks(color, s);
+	targets &= b->getColorPieces(!color);
+	unsigned int count = Bitboards::popCount(targets);
+	// a pawn is never on its last row, it promotes on reaching it
+	if (empty & Bitboards::bit(s + offset)) {
+		count++;
+		// moving two spaces is only available from a pawn's initial row
+		bool initial = (r == ((getColor() == WHITE) ? 1 : ROWS-2));
+		if (initial && (empty & Bitboards::bit(s + (2 * offset)))) {
+			count++;
+		}
+	}
+	return count;
 }
\ No newline at end of file
@@ -16,8 +16,9 @@ class Pawn : public Piece {
 		const static bool WHITE = true, BLACK = false;
 	public:
 		Pawn(bool); // constructor
-		std::shared_ptr<Piece> clone() const; // copy constructor
 
 		// member methods
-		std::vector<Move> getMoves(Board*, unsigned int, unsigned int);
+		void getMoves(Board*, unsigned int, unsigned int, MoveList&,
+						Bitboard) const;
+		unsigned int countMoves(Board*, unsigned int, unsigned int) const;
 };
@@ -1,39 +1,66 @@
 #include "Piece.hpp"
+#include "Pawn.hpp"
+#include "Knight.hpp"
+#include "Bishop.hpp"
+#include "Rook.hpp"
+#include "Queen.hpp"
+#include "King.hpp"
 
 /**
  * Piece class definition
  */
 
+// the shared pieces, built once at startup and never changed after
+namespace {
+	const Pawn pawns[2] = { Pawn(false), Pawn(true) };
+	const Knight knights[2] = { Knight(false), Knight(true) };
+	const Bishop bishops[2] = { Bishop(false), Bishop(true) };
+	const Rook rooks[2] = { Rook(false), Rook(true) };
+	const Queen queens[2] = { Queen(false), Queen(true) };
+	const King kings[2] = { King(false), King(true) };
+	// indexed by color, then by the Piece type indices
+	const Piece* const shared[2][Piece::TYPES] = {
+		{ &pawns[0], &knights[0], &bishops[0], &rooks[0], &queens[0],
+			&kings[0] },
+		{ &pawns[1], &knights[1], &bishops[1], &rooks[1], &queens[1],
+			&kings[1] }
+	};
+}
+
 /**
  * piece class constructor
  * @param c - the color of the piece
  * @param v - the value of the piece
- * @param t - the type of the piece
+ * @param t - the type of the piece, as white shows it
  */
 Piece::Piece(bool c, unsigned int v, char t)
-	: color(c), value(v), hasMoved(false) {
-		setType(t);
-}
+	: color(c), value(v), type((c) ? t : t + 32) {}
 
 // virtual destructor
 Piece::~Piece() {}
 
+/**
+ * method to find the piece of a color and type, the same piece every time
+ * so tiles and boards share it rather than allocating their own
+ * @param c - the color of the piece
+ * @param t - the type of the piece, one of the type indices
+ * @return - the shared piece
+ */
+const Piece& Piece::get(bool c, unsigned int t) {
+	return *shared[c][t];
+}
+
 /**
  * method to confirm a move is valid (within bounds)
  * @param c - the columnar coordinate of the move
  * @param r - the row coordinate of the move
  * @return - whether the move is within the board
  */
-bool Piece::checkInBounds(unsigned int c, unsigned int r) {
+bool Piece::checkInBounds(unsigned int c, unsigned int r) const {
 	return (r < ROWS) && (c < COLS);
 }
 
 // accessor methods
-bool Piece::getMoved() { return hasMoved; }
-bool Piece::getColor() { return color; }
-unsigned int Piece::getValue() { return value; }
-char Piece::getType() { return type; }
-
-// mutator methods
-void Piece::setMoved(bool m) { hasMoved = m; }
-inline void Piece::setType(char t) { type = (getColor() == 1) ? t : t + 32; }
+bool Piece::getColor() const { return color; }
+unsigned int Piece::getValue() const { return value; }
+char Piece::getType() const { return type; }
@@ -1,11 +1,16 @@
 #pragma once
-#include "../game/Move.hpp"
+#include "../game/MoveList.hpp"
+#include "../board/Bitboards.hpp"
 #include <vector>
-#include <memory> // for shared_ptr
 
 class Board; // forward declaration
 
-// Piece class declaration, base class for derived pieces
+/**
+ * Piece class declaration, base class for derived pieces. A piece is only its
+ * color and type, where it stands and whether it has moved are kept by the
+ * board, so there is one immutable piece per color and type (see get) shared
+ * by every tile holding one
+ */
 
 class Piece {
 	protected:
@@ -13,30 +18,28 @@ class Piece {
 
 		const static unsigned int ROWS = 8, COLS = 8;
 
-		bool color; // the color of the piece
-		unsigned int value; // the value of the piece
-		bool hasMoved; // whether piece has moved or not (K, R, P)
-		char type; // what kind of piece it is
+		const bool color; // the color of the piece
+		const unsigned int value; // the value of the piece
+		const char type; // what kind of piece it is
 
 		// protected member methods
-		bool checkInBounds(unsigned int, unsigned int);
+		bool checkInBounds(unsigned int, unsigned int) const;
 	public:
-		virtual ~Piece(); // destructor
+		// piece type indices, used to index the board's bitboards
+		const static unsigned int PAWN = 0, KNIGHT = 1, BISHOP = 2, ROOK = 3;
+		const static unsigned int QUEEN = 4, KING = 5, TYPES = 6;
 
-		// pure abstract copy constructor
-		virtual std::shared_ptr<Piece> clone() const=0;
+		virtual ~Piece(); // destructor
 
 		// public member methods
-		virtual std::vector<Move> getMoves(Board*, unsigned int, 
-										unsigned int)=0;
+		static const Piece& get(bool, unsigned int);
+		virtual void getMoves(Board*, unsigned int, unsigned int,
+								MoveList&, Bitboard) const=0;
+		virtual unsigned int countMoves(Board*, unsigned int,
+										unsigned int) const=0;
 
 		// accessor methods
-		bool getMoved();
-		bool getColor();
-		unsigned int getValue();
-		char getType();
-
-		// mutator methods
-		void setMoved(bool);
-		void setType(char);
+		bool getColor() const;
+		unsigned int getValue() const;
+		char getType() const;
 };
@@ -10,54 +10,38 @@ Rook::Rook(bool c)
 	: Piece(c, GameParams::R_VAL, 'R') {} // chain into base constructor
 
 /**
- * explicit copy constructor
- * @return - a copy of this object
+ * method to determine which moves this piece may make, appends the valid moves
+ * the piece can make to a collection
+ * @param b - the board the piece is on
+ * @param c - the columnar coordinate of the piece
+ * @param r - the row coordinate of the piece
+ * @param moveList - the collection of moves to append to
+ * @param mask - the tiles the moves may end on, others are skipped
  */
-std::shared_ptr<Piece> Rook::clone() const {
-	return std::shared_ptr<Piece>(new Rook(*this));
+void Rook::getMoves(Board* b, unsigned int c, unsigned int r,
+					MoveList &moveList, Bitboard mask) const {
+	// every tile along every ray up to and including the first piece met
+	unsigned int s = Bitboards::index(c, r);
+	Bitboard targets = Bitboards::rookAttacks(s, b->getOccupied());
+	// capturing opposing pieces is valid, own pieces are not
+	targets &= ~b->getColorPieces(color) & mask;
+	while (targets) {
+		unsigned int t = Bitboards::popLsb(targets);
+		moveList.push_back(Move(c, r, t % COLS, t / COLS));
+	}
 }
 
 /**
- * method to determine which moves this piece may make, creates a collection of
- * valid moves the piece can make
+ * method to count the moves this piece may make without building them, the
+ * destinations are the attacked tiles not held by its own color
  * @param b - the board the piece is on
  * @param c - the columnar coordinate of the piece
  * @param r - the row coordinate of the piece
- * @return - a collection of moves this piece may make
+ * @return - the number of moves getMoves would find
  */
-std::vector<Move> Rook::getMoves(Board* b, unsigned int c, unsigned int r) {
-	std::vector<Move> moveList;
-	for (unsigned int j = 0; j < MOVE_NUM; j++) {
-		int x = c, y = r; // signed as it may be OOB later
-		for (unsigned int i = MIN_MOVE; i < MAX_MOVE; i++, x = c, y = r) {
-			switch(j) {
-				case 0: y += i; break; // north
-				case 1: x += i; break; // east
-				case 2: y -= i; break; // south
-				case 3: x -= i; break; // west
-			}
-			// determine if the move is valid
-			if (checkInBounds(x, y)) { // if valid board position
-				Tile possibleMove = (*b)(x, y);
-				if (possibleMove) { // if tile is occupied
-					// if occupying piece is opposing color
-					if (possibleMove.getPiece().getColor() != color) {
-						// capturing the piece is a valid move
-						moveList.push_back(Move(c, r, x, y));
-					}
-					break; // cannot go over pieces
-				} else { // if tile is not occupied
-					// by default, a non-occupied tile is a valid move
-					moveList.push_back(Move(c, r, x, y));
-				}
-			} else {
-				/**
-				 * if a move is outside of bounds, it's reasonable to assume
-				 * one move further in the same direction is also out of bounds
-				 */
-				break;
-			}
-		}
-	}
-	return moveList;
+unsigned int Rook::countMoves(Board* b, unsigned int c,
+								unsigned int r) const {
+	unsigned int s = Bitboards::index(c, r);
+	Bitboard targets = Bitboards::rookAttacks(s, b->getOccupied());
+	return Bitboards::popCount(targets & ~b->getColorPieces(color));
 }
\ No newline at end of file
@@ -6,146 +6,546 @@
  * Computer class constructor
  * @param c - color of this player
  * @param d - the depth for AI tree search
+ * @param h - the transposition table size in megabytes
+ * @param t - the number of search threads
  */
-Computer::Computer(bool c, unsigned int d) {
+Computer::Computer(bool c, unsigned int d, unsigned int h, unsigned int t)
+	: table(new TransTable(h)), stopped(new std::atomic<bool>(false)),
+		ponderer(new std::thread()), pondering(new std::atomic<bool>(false)) {
 	setColor(c);
 	setDepth(d);
+	setThreads(t);
+	for (unsigned int i = 0; i < SQUARES; i++) {
+		for (unsigned int j = 0; j < SQUARES; j++) {
+			history[false][i][j] = 0; history[true][i][j] = 0;
+		}
+	}
+	ageOrdering();
 }
 
 /**
- * method to prompt user for their move
+ * method to prompt user for their move, searches with iterative deepening:
+ * depth 1, then 2, and so on up to the search depth. Each iteration searches
+ * the previous iteration's best move first, which together with the
+ * transposition table orders the deeper searches for more pruning
  * @return - the move they've chosen
  */
 Move Computer::promptMove() {
-	return negamaxHandler(INT_MIN, INT_MAX);
-}
-
-/**
- * negamax handler, performs the first level of negamax and compares the values
- * of further calls to generate the best move as dictated by the AI
- * @param alf - alpha
- * @param bet - beta
- * @return - optimal AI move
- */
-Move Computer::negamaxHandler(int alf, int bet) {
-	// get all moves AI can make
-	std::vector<Move> moveList = getBoard()->getAllMoves(!getColor());
-	// remove moves which would put AI in check
-	removeCheckedMoves(moveList);
-	int bestMoveValue = INT_MIN; // initially -inf
-	std::vector<Move> bestMoves; // collection of best moves
-	// for each possible move
-	for (unsigned int i = 0; i < moveList.size(); i++) {
+	/**
+	 * should the opponent have played the reply expected, the ponder search
+	 * is already searching this position and carries on as this search
+	 */
+	bool hit = ponderer->joinable() && getBoard()->getKey() == ponderKey;
+	if (hit) {
+		pondering->store(false); // the clock starts from here on
+		ponderer->join();
+		// should the search have finished first, the move took no time
+		onOpponentTime();
+	} else {
+		stopPondering();
+		root = getBoard();
+		MoveList moveList;
 		/**
-		 * to avoid threefold repetition, we need to handle cases where a move
-		 * is repeated. Mostly evident in AI vs AI games where it will go on
-		 * forever as they move pieces back and forth ad infinitum. This
-		 * prevents reuse of the previous moves the amount of which is
-		 * determined by a buffer. Added benefits of less negamax calls meaning
-		 * faster speed
+		 * unable to catch instances where the movelist is zero leading to
+		 * null move, so consider this the AI forfeiting
 		 */
-		std::string toFind = moveList[i].stateMove();
-		if (std::find(buffer.begin(), buffer.end(), toFind) != buffer.end()) {
-			continue; // if move found in buffer, don't perform negamax
-		}
-		Board* copy = new Board(*getBoard()); // make a new board copy
-		copy->movePiece(moveList[i]); // make move on copy
-		// find value of that move
-		int v = -negamax(copy, getDepth()-1, -bet, -alf, !getColor());
-		delete copy;
-		// if same worth or not enough to fill queue
-		if (v == bestMoveValue || moveList.size() <= GameParams::BUFFER_SIZE) {
-			// add it to the collection
-			bestMoves.push_back(moveList[i]);
-		} else if (v > bestMoveValue) {
-			// add it to the list of possible moves and update best score
-			bestMoveValue = v;
-			bestMoves.clear(); // don't need worse moves
-			bestMoves.push_back(moveList[i]);
+		if (!findRootMoves(moveList)) {
+			std::cout << (getColor() ? "White" : "Black");
+			std::cout << " has forfeited the game.\n\n";
+			exit(0); // impossible to unwrap into main()
 		}
-		// update alpha if better best move value
-		if (bestMoveValue > alf) { alf = bestMoveValue;	}
-		// prune further moves
-		if (alf >= bet) { pruneCount++; break; }
-	}
-	/**
-	 * unable to catch instances where the movelist is zero leading to null
-	 * move, so consider this the AI forfeiting
-	 */
-	if (bestMoves.size() == 0) {
-		std::cout << (getColor() ? "White" : "Black");
-		std::cout << " has forfeited the game.\n\n";
-		exit(0); // impossible to unwrap into main()
+		beginSearch();
+		search(moveList);
 	}
-	/**
-	 * because some moves will be worth the same as others, AI will have a
-	 * collection of the best moves here. Choose one stochastically
-	 */
-	Move theBestMove = bestMoves[rand() % bestMoves.size()];
-	buffer.push_back(theBestMove.stateMove()); // add best move to buffer
-	// keep buffer size consistent
-	if (buffer.size() > GameParams::BUFFER_SIZE) {
-		buffer.erase(buffer.begin());
+	root = getBoard();
+	Move theBestMove = bestMove;
+	findPrincipalVariation(getDepth());
+	// on the clock, the time taken comes off it and the increment goes on
+	if (clockTime > 0) {
+		unsigned int ms = elapsed();
+		clockTime = ((clockTime > ms) ? clockTime - ms : 1) + increment;
 	}
+	// a UCI front end keeps the game and reports the move itself
+	if (uci) { return theBestMove; }
 	// find the value of that move
-	Board* copy = new Board(*getBoard());
-	copy->movePiece(theBestMove);
+	int bestMoveValue;
+	Board board(*getBoard());
+	board.movePiece(theBestMove);
+	Status status;
+	board.classify(!getColor(), status);
 	// if move checkmates opponent
-	if (copy->determineCheckmate(!getColor())) {
+	if (status.checkmate) {
 		bestMoveValue = GameParams::CHECKMATE;
 	// if move stalemates
-	} else if (copy->determineStalemate(!getColor())) {
+	} else if (status.stalemate) {
 		bestMoveValue = GameParams::STALEMATE;
 	// if move draws
-	} else if (copy->determineDraw()) {
+	} else if (status.draw) {
 		bestMoveValue = GameParams::DRAW;
 	// if move puts opponent in check
-	} else if (copy->determineCheck(!getColor())) {
-		bestMoveValue = GameParams::CHECK * evalBoard(copy);
+	} else if (status.check) {
+		bestMoveValue = GameParams::CHECK * evalBoard(&board);
 	// otherwise vanilla value
 	} else {
-		bestMoveValue = evalBoard(copy);
+		bestMoveValue = evalBoard(&board);
 	}
-	delete copy;
-	printData(bestMoveValue, bestMoves.size()); // show some data
+	printData(bestMoveValue); // show some data
+	if (hit) { std::cout << "The reply was foreseen, saving time.\n"; }
+	startPondering(theBestMove);
 	return theBestMove;
 }
 
+/**
+ * method to find the moves the AI may make at the root
+ * @param moveList - the collection to fill
+ * @return - whether there is any move to make
+ */
+bool Computer::findRootMoves(MoveList &moveList) {
+	// get all moves AI can make without putting itself in check
+	moveList = root->getStatus(getColor()).moves;
+	return moveList.size() > 0;
+}
+
+/**
+ * method to ready the AI for a search, done on the calling thread before any
+ * search thread starts so that the search thread sees it all
+ */
+void Computer::beginSearch() {
+	startTime = std::chrono::steady_clock::now();
+	infoTime = startTime;
+	allocateTime();
+	completed = 0;
+	evalCount = 0; pruneCount = 0;
+	table->newSearch(); // age out entries from earlier moves
+	ageOrdering(); // likewise for the move ordering tables
+}
+
+/**
+ * method to search the root moves with iterative deepening until the depth or
+ * a limit is reached, leaving the best move in bestMove
+ * @param moveList - the root moves, at least one
+ */
+void Computer::search(MoveList moveList) {
+	bestMove = moveList[0]; // something to play before any search
+	/**
+	 * lazy SMP: helper threads search the same tree alongside this one, each
+	 * on its own copy of the AI and the board, sharing only the transposition
+	 * table. What they store there steers and cuts off this thread's search,
+	 * and this thread's result is the one played
+	 */
+	std::vector<Computer> helpers(getThreads() - 1, *this);
+	std::vector<Board> boards(getThreads() - 1, *root);
+	std::vector<std::thread> workers;
+	for (unsigned int i = 0; i < helpers.size(); i++) {
+		helpers[i].root = &boards[i];
+		workers.push_back(std::thread(&Computer::helperSearch, &helpers[i],
+										moveList, i + 1));
+	}
+	int score = 0;
+	for (unsigned int d = 1; d <= getDepth(); d++) {
+		score = aspirationSearch(moveList, d, score);
+		// a stopped iteration is discarded, the last full one stands
+		if (stopped->load()) { break; }
+		completed = d;
+		if (uci) { findPrincipalVariation(d); printInfo(d, score); }
+		// time only counts once the opponent has moved
+		if (onOpponentTime()) { continue; }
+		// past the soft limit the next, longer, iteration is not begun
+		if (softLimit > 0 && elapsed() >= softLimit) { break; }
+	}
+	// the result is in, so call off and collect the helpers
+	stopped->store(true);
+	for (unsigned int i = 0; i < workers.size(); i++) {
+		workers[i].join();
+		evalCount += helpers[i].evalCount;
+		pruneCount += helpers[i].pruneCount;
+	}
+	stopped->store(false); // ready for the next search
+}
+
+/**
+ * method to search on the opponent's time, the AI expects the opponent to
+ * reply as its principal variation has it and searches the position after
+ * that reply on another thread while the opponent thinks
+ * @param m - the move the AI is about to make
+ */
+void Computer::startPondering(Move m) {
+	if (!ponder || pv.size() < 2) { return; }
+	ponderBoard = *getBoard();
+	ponderBoard.movePiece(m);
+	ponderBoard.movePiece(pv[1]);
+	root = &ponderBoard;
+	MoveList moveList;
+	if (!findRootMoves(moveList)) { root = getBoard(); return; }
+	ponderKey = ponderBoard.getKey();
+	pondering->store(true);
+	beginSearch();
+	ponderClock = true;
+	*ponderer = std::thread(&Computer::search, this, moveList);
+}
+
+/**
+ * method for a search begun on the opponent's time to tell whether it still
+ * is, the search thread starts its clock itself once the reply is played so
+ * that no other thread touches the limits it reads
+ * @return - whether time does not count yet
+ */
+bool Computer::onOpponentTime() {
+	if (!ponderClock) { return false; }
+	if (pondering->load()) { return true; }
+	ponderClock = false;
+	startTime = std::chrono::steady_clock::now();
+	allocateTime();
+	return false;
+}
+
+/**
+ * method to tell the AI the game is over, a search still running on the
+ * opponent's time must not outlive the game
+ */
+void Computer::endGame() {
+	stopPondering();
+}
+
+/**
+ * method to call off the ponder search should the opponent not reply as
+ * expected, what it stored in the transposition table is kept
+ */
+void Computer::stopPondering() {
+	if (!ponderer->joinable()) { return; }
+	stopped->store(true);
+	ponderer->join();
+	pondering->store(false);
+	ponderClock = false;
+	stopped->store(false);
+}
+
+/**
+ * method to search the root to some depth inside an aspiration window, a
+ * narrow window around the previous iteration's score prunes far more than a
+ * full one. A score outside the window is only a bound, so the window is then
+ * widened and the root searched again until the score falls inside it
+ * @param moveList - the moves to search, reordered on return
+ * @param d - the depth to search to
+ * @param score - the previous iteration's score
+ * @return - the best score found
+ */
+int Computer::aspirationSearch(MoveList &moveList, unsigned int d, int score) {
+	if (d < ASPIRATION_DEPTH) {
+		return negamaxHandler(moveList, d, -INT_MAX, INT_MAX);
+	}
+	int window = ASPIRATION_WINDOW;
+	while (true) {
+		// once the window spans every score, it may as well be infinite
+		bool full = window > 2 * GameParams::CHECKMATE;
+		int alf = (full) ? -INT_MAX : score - window;
+		int bet = (full) ? INT_MAX : score + window;
+		int v = negamaxHandler(moveList, d, alf, bet);
+		if (stopped->load(std::memory_order_relaxed)) { return v; }
+		if (full || (v > alf && v < bet)) { return v; }
+		window *= 4;
+	}
+}
+
+/**
+ * negamax handler, performs the first level of negamax and compares the values
+ * of further calls to find the best move as dictated by the AI. Like negamax,
+ * it searches as a principal variation search. The best move of a completed
+ * iteration is kept in bestMove and moved to the front of the move list for
+ * the next iteration
+ * @param moveList - the moves to search, reordered on return
+ * @param d - the depth to search to
+ * @param alf - alpha
+ * @param bet - beta
+ * @return - the best score found
+ */
+int Computer::negamaxHandler(MoveList &moveList, unsigned int d, int alf,
+								int bet) {
+	int alfOrig = alf;
+	int bestMoveValue = INT_MIN; // initially -inf
+	unsigned int best = 0; // index of the best move
+	// the whole tree is searched by making and unmaking moves on one copy
+	Board board(*root);
+	// for each possible move
+	for (unsigned int i = 0; i < moveList.size(); i++) {
+		Undo u;
+		board.makeMove(moveList[i], u); // make move on the search board
+		// find value of that move, see negamax for the null window
+		int v;
+		if (i == 0) {
+			v = -negamax(&board, d-1, 1, -bet, -alf, !getColor(), true);
+		} else {
+			v = -negamax(&board, d-1, 1, -alf-1, -alf, !getColor(), true);
+			if (v > alf && v < bet) {
+				v = -negamax(&board, d-1, 1, -bet, -alf, !getColor(), true);
+			}
+		}
+		board.unmakeMove(moveList[i], u);
+		if (v > bestMoveValue) { bestMoveValue = v; best = i; }
+		// update alpha if better best move value
+		if (bestMoveValue > alf) { alf = bestMoveValue;	}
+		// prune further moves
+		if (alf >= bet) { pruneCount++; break; }
+	}
+	// an iteration cut short by a stop has no trustworthy result
+	if (stopped->load(std::memory_order_relaxed)) { return bestMoveValue; }
+	// nor has one where every move failed low, the order is unknown
+	if (bestMoveValue <= alfOrig) { return bestMoveValue; }
+	bestMove = moveList[best];
+	// search the best move first next iteration, the rest keep their order
+	std::rotate(moveList.begin(), moveList.begin() + best,
+				moveList.begin() + best + 1);
+	return bestMoveValue;
+}
+
+/**
+ * method run by each helper thread, an iterative deepening search like the
+ * main thread's but varied so that threads do not walk the tree in lockstep:
+ * each starts from a rotated root move order, and odd helpers search one ply
+ * deeper than the main thread at each iteration
+ * @param moveList - the root moves to search
+ * @param id - the helper number, from 1
+ */
+void Computer::helperSearch(MoveList moveList, unsigned int id) {
+	// only the main thread watches the limits or reports progress
+	uci = false;
+	nodeLimit = 0;
+	hardLimit = 0;
+	ponderClock = false;
+	std::rotate(moveList.begin(), moveList.begin() + (id % moveList.size()),
+				moveList.end());
+	int score = 0;
+	for (unsigned int d = 1; d <= getDepth(); d++) {
+		if (stopped->load(std::memory_order_relaxed)) { break; }
+		score = aspirationSearch(moveList, d + (id % 2), score);
+	}
+}
+
 /**
  * negamax implementation using alpha-beta pruning, will search tree space
  * recursively but without the typical two function calls that minimax uses
  * negamax relies on the property of max(alf, bet) == -min(-alf, -bet) which is
- * equivalent or better than vanilla minimax
+ * equivalent or better than vanilla minimax. It is a principal variation
+ * search: with good move ordering the first move is usually best, so the rest
+ * are only searched with a null window (alf, alf+1) proving them no better.
+ * The few which prove better are searched again with the full window. Lines
+ * unlikely to matter are pruned or reduced, see GameParams for the switches
  * @param b - the board to checkmate
  * @param d - the depth to use to break out of algorithm
+ * @param ply - the distance from the root
  * @param alf - alpha
  * @param bet - beta
  * @param p - the calling player
+ * @param nullOk - whether a null move may be tried, never twice in a row
  * @return - best evaluation for AI
  */
-int Computer::negamax(Board* b, unsigned int d, int alf, int bet, bool p) {
+int Computer::negamax(Board* b, unsigned int d, unsigned int ply, int alf,
+						int bet, bool p, bool nullOk) {
+	// at depth zero, play out the captures before trusting the evaluation
+	if (d == 0) { return quiesce(b, alf, bet, p); }
 	evalCount++; // increment count to display positions evaluated
+	if (evalCount % POLL_NODES == 0) { poll(); }
+	// once stopped, unwind quickly, the caller discards the result
+	if (stopped->load(std::memory_order_relaxed)) { return 0; }
 	int offset = (p == getColor() ? 1 : -1); // vary based on color
-	// terminal cases would be stalemate or checkmate or depth zero
-	if (d == 0) { return offset * evalBoard(b); }
-	// consider a checkmate as worst possible position
-	if (b->determineCheckmate(p)) { return -GameParams::CHECKMATE; }
-	// consider a stalemate as neither good or bad
-	if (b->determineStalemate(p)) { return GameParams::STALEMATE; }
-	// likewise for draw
-	if (b->determineDraw()) { return GameParams::DRAW; }
-	// putting another person in check is beneficial
+	/**
+	 * mate distance pruning, no line from here mates sooner than next ply or
+	 * is mated sooner than this one, so with a shorter mate already found
+	 * elsewhere the window closes
+	 */
+	if (GameParams::MATE_DISTANCE) {
+		alf = std::max(alf, -GameParams::CHECKMATE + (int)ply);
+		bet = std::min(bet, GameParams::CHECKMATE - (int)ply - 1);
+		if (alf >= bet) { return alf; }
+	}
+	/**
+	 * a position repeated since the last capture or pawn move is scored as a
+	 * draw, as whatever was played from it may be played again. Likewise once
+	 * fifty moves have gone by or neither side can mate, and the whole subtree
+	 * below goes unsearched
+	 */
+	if (b->isRepetition() || b->isFiftyMoves()) { return GameParams::DRAW; }
+	if (b->isInsufficientMaterial()) { return GameParams::DRAW; }
+	// reuse what an earlier search of this position found
+	int alfOrig = alf;
+	unsigned int hashDepth, hashBound;
+	int hashScore;
+	Move hashMove;
+	bool hashHit = table->probe(b->getKey(), hashDepth, hashBound, hashScore,
+								hashMove);
+	if (hashHit) { hashScore = fromTable(hashScore, ply); }
+	if (hashHit && hashDepth >= d) {
+		if (hashBound == TransTable::EXACT) { return hashScore; }
+		if (hashBound == TransTable::LOWER && hashScore >= bet) {
+			return hashScore;
+		}
+		if (hashBound == TransTable::UPPER && hashScore <= alf) {
+			return hashScore;
+		}
+	}
+	/**
+	 * putting another person in check is beneficial, unless it is mate. In
+	 * check only the few moves out of it are generated, and with none it is
+	 * mate. Draws were ruled out above, so nothing else need be classified
+	 */
 	if (b->determineCheck(p)) {
+		MoveList evasions;
+		b->getAllMoves(p, evasions);
+		// consider a checkmate as worst possible position, sooner being worse
+		if (evasions.size() == 0) { return -GameParams::CHECKMATE + (int)ply; }
 		return (GameParams::CHECK * offset) * evalBoard(b);
 	}
+	// past here the player to move is not in check
+	bool pvNode = bet - alf > 1; // whether the exact score matters
+	bool nullMove = GameParams::NULL_MOVE && nullOk && !pvNode;
+	nullMove = nullMove && d > GameParams::NULL_MOVE_R;
+	// pawn endings are too often zugzwang, where passing would be best
+	Bitboard pawns = b->getPieces(p, Piece::PAWN);
+	Bitboard pieces = b->getColorPieces(p) & ~b->getPieces(p, Piece::KING);
+	nullMove = nullMove && (pieces & ~pawns);
+	bool futile = GameParams::FUTILITY && !pvNode;
+	futile = futile && d <= GameParams::FUTILITY_DEPTH;
+	futile = futile && alf > -MATE_BOUND && alf < MATE_BOUND;
+	int eval = (nullMove || futile) ? offset * evalBoard(b) : 0;
+	/**
+	 * null move pruning, let the opponent move twice: should a reduced search
+	 * still fail high, a real move surely would too
+	 */
+	if (nullMove && eval >= bet) {
+		Undo u;
+		b->makeNullMove(u);
+		unsigned int r = GameParams::NULL_MOVE_R;
+		int v = -negamax(b, d-1-r, ply+1, -bet, -bet+1, !p, false);
+		b->unmakeNullMove(u);
+		if (stopped->load(std::memory_order_relaxed)) { return 0; }
+		// a mate found without moving is not proven, so keep to beta
+		if (v >= bet) { return (v >= MATE_BOUND) ? bet : v; }
+	}
+	/**
+	 * futility pruning, near the leaves a quiet move will not gain enough to
+	 * bring an evaluation far below alpha up to it
+	 */
+	futile = futile && eval + (GameParams::FUTILITY_MARGIN * (int)d) <= alf;
 	int value = INT_MIN; // initially minimum (will overwrite)
-	std::vector<Move> moveList = b->getAllMoves(!p); // get moves of opponent
-	for (unsigned int i = 0; i < moveList.size(); i++) {
-		Board* copy = new Board(*b); // make a new board copy
-		copy->movePiece(moveList[i]); // make move on copy
-		// then recurse
-		int v = -negamax(copy, d-1, -bet, -alf, !p);
-		delete copy;
+	// moves come likeliest cutoff first, generated only as they are needed
+	MovePicker picker(b, p, hashHit, hashMove,
+						(ply < MAX_PLY) ? killers[ply] : NULL, history[p]);
+	Move move, nodeBest(0, 0, 0, 0);
+	unsigned int searched = 0; // number of moves searched so far
+	while (picker.next(move)) {
+		Undo u;
+		b->makeMove(move, u); // make move
+		// moves which capture, promote or check are never pruned or reduced
+		bool quiet = u.captured == Piece::TYPES && !u.promoted;
+		quiet = quiet && !b->determineCheck(!p);
+		if (futile && quiet && searched > 0) {
+			b->unmakeMove(move, u);
+			value = std::max(value, eval);
+			continue;
+		}
+		// then recurse, with a null window after the first move
+		int v;
+		if (searched == 0) {
+			v = -negamax(b, d-1, ply+1, -bet, -alf, !p, true);
+		} else {
+			/**
+			 * late move reductions, a quiet move ordered this late is unlikely
+			 * to be best, so search it a ply shallower unless that proves it
+			 * better after all
+			 */
+			unsigned int r = 0;
+			if (GameParams::LMR && quiet && d >= GameParams::LMR_DEPTH) {
+				r = (searched >= GameParams::LMR_MOVES) ? 1 : 0;
+			}
+			v = -negamax(b, d-1-r, ply+1, -alf-1, -alf, !p, true);
+			if (r > 0 && v > alf) {
+				v = -negamax(b, d-1, ply+1, -alf-1, -alf, !p, true);
+			}
+			// it proved better, so search again to find by how much
+			if (v > alf && v < bet) {
+				v = -negamax(b, d-1, ply+1, -bet, -alf, !p, true);
+			}
+		}
+		searched++;
+		b->unmakeMove(move, u); // and take it back
+		if (v > value) { value = v; nodeBest = move; }
+		alf = std::max(alf, value);
+		if (alf >= bet) { // cutoff for branches
+			pruneCount++;
+			// remember quiet moves which cut off, captures are found anyway
+			if (u.captured == Piece::TYPES) { storeCutoff(move, d, ply, p); }
+			break;
+		}
+	}
+	// a stopped search has not finished this node, so do not store it
+	if (stopped->load(std::memory_order_relaxed)) { return 0; }
+	// no move to make while not in check is a stalemate, neither good or bad
+	if (searched == 0) { return GameParams::STALEMATE; }
+	// remember the result and how far it can be trusted
+	unsigned int bound = TransTable::EXACT;
+	if (value <= alfOrig) {
+		bound = TransTable::UPPER;
+	} else if (value >= bet) {
+		bound = TransTable::LOWER;
+	}
+	table->store(b->getKey(), d, bound, toTable(value, ply), nodeBest);
+	return value;
+}
+
+/**
+ * method to convert a score for storing in the transposition table, a mate
+ * score counts plies from the root, but the position may be reached again at
+ * another ply so the table counts from the position instead
+ * @param s - the score
+ * @param ply - the distance from the root
+ * @return - the score to store
+ */
+int Computer::toTable(int s, unsigned int ply) {
+	if (s >= MATE_BOUND) { return s + (int)ply; }
+	if (s <= -MATE_BOUND) { return s - (int)ply; }
+	return s;
+}
+
+/**
+ * method to convert a score from the transposition table, undoing toTable
+ * @param s - the stored score
+ * @param ply - the distance from the root
+ * @return - the score
+ */
+int Computer::fromTable(int s, unsigned int ply) {
+	if (s >= MATE_BOUND) { return s - (int)ply; }
+	if (s <= -MATE_BOUND) { return s + (int)ply; }
+	return s;
+}
+
+/**
+ * quiescence search, evaluating a position in the middle of an exchange
+ * misjudges it (the horizon effect), so leaves search on through captures and
+ * promotions until the position is quiet. The player to move may also "stand
+ * pat" and decline every capture, so the evaluation is a lower bound
+ * @param b - the board to search
+ * @param alf - alpha
+ * @param bet - beta
+ * @param p - the calling player
+ * @return - best evaluation for AI
+ */
+int Computer::quiesce(Board* b, int alf, int bet, bool p) {
+	evalCount++; // increment count to display positions evaluated
+	if (evalCount % POLL_NODES == 0) { poll(); }
+	// once stopped, unwind quickly, the caller discards the result
+	if (stopped->load(std::memory_order_relaxed)) { return 0; }
+	int offset = (p == getColor() ? 1 : -1); // vary based on color
+	int value = offset * evalBoard(b); // the stand pat score
+	if (value >= bet) { return value; }
+	alf = std::max(alf, value);
+	// only captures and promotions are generated, never the quiet moves
+	MovePicker picker(b, p);
+	Move move;
+	while (picker.next(move)) {
+		Undo u;
+		b->makeMove(move, u);
+		int v = -quiesce(b, -bet, -alf, !p);
+		b->unmakeMove(move, u);
 		value = std::max(value, v);
 		alf = std::max(alf, value);
 		if (alf >= bet) { pruneCount++; break; } // cutoff for branches
@@ -153,6 +553,47 @@ int Computer::negamax(Board* b, unsigned int d, int alf, int bet, bool p) {
 	return value;
 }
 
+/**
+ * method to remember a quiet move which caused a cutoff, as a killer for other
+ * positions at the same ply and in the history of its color
+ * @param m - the move
+ * @param d - the depth searched below the move's position
+ * @param ply - the distance from the root
+ * @param p - the moving player
+ */
+void Computer::storeCutoff(const Move &m, unsigned int d, unsigned int ply,
+							bool p) {
+	if (ply < MAX_PLY && !(m == killers[ply][0])) {
+		killers[ply][1] = killers[ply][0];
+		killers[ply][0] = m;
+	}
+	unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+	unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+	// deeper cutoffs save more work, so weigh them more
+	history[p][orig][dest] += d * d;
+	if (history[p][orig][dest] > HISTORY_MAX) { ageHistory(); }
+}
+
+/**
+ * method to forget killers and fade the history before a search, killers
+ * belong to the plies of one search while history stays a fair guide longer
+ */
+void Computer::ageOrdering() {
+	for (unsigned int i = 0; i < MAX_PLY; i++) {
+		killers[i][0] = Move(0, 0, 0, 0); killers[i][1] = Move(0, 0, 0, 0);
+	}
+	ageHistory();
+}
+
+// method to halve the history, keeping its order but letting new cutoffs count
+void Computer::ageHistory() {
+	for (unsigned int i = 0; i < SQUARES; i++) {
+		for (unsigned int j = 0; j < SQUARES; j++) {
+			history[false][i][j] /= 2; history[true][i][j] /= 2;
+		}
+	}
+}
+
 /**
  * method to evaluate a board's worth
  * @param b - the board to evaluate
@@ -179,26 +620,192 @@ int Computer::evalBoard(Board* b) {
 	return (c1*value) + (c2*mobility) + (c3*pawns);
 }
 
+/**
+ * method to follow the principal variation, the line of play both players are
+ * expected to take, through the transposition table from the best move. It
+ * stops early wherever the table no longer holds an exact score
+ * @param d - the most moves to follow
+ */
+void Computer::findPrincipalVariation(unsigned int d) {
+	pv.clear();
+	pv.push_back(bestMove);
+	Board board(*root);
+	board.movePiece(bestMove);
+	bool p = !getColor();
+	while (pv.size() < d) {
+		unsigned int hashDepth, hashBound;
+		int hashScore;
+		Move m;
+		if (!table->probe(board.getKey(), hashDepth, hashBound, hashScore, m)) {
+			break;
+		}
+		// an entry may be from another position sharing the key
+		if (hashBound != TransTable::EXACT || !board.isLegal(p, m)) {
+			break;
+		}
+		board.movePiece(m);
+		pv.push_back(m);
+		p = !p;
+	}
+}
+
+/**
+ * method to work out how long to search, for a fixed time per move or from
+ * the clock, see GameParams for how the clock is shared out between moves
+ */
+void Computer::allocateTime() {
+	softLimit = 0; hardLimit = 0;
+	if (moveTime > 0) {
+		softLimit = moveTime; hardLimit = moveTime;
+	} else if (clockTime > 0) {
+		unsigned int left = 1;
+		if (clockTime > GameParams::TIME_MARGIN) {
+			left = clockTime - GameParams::TIME_MARGIN;
+		}
+		unsigned int moves = GameParams::MOVES_TO_GO;
+		if (movesToGo > 0) { moves = movesToGo; }
+		softLimit = std::min((left / moves) + increment, left / 2);
+		hardLimit = std::min(softLimit * GameParams::TIME_HARD, left / 2);
+		softLimit = std::max(softLimit, 1u);
+		hardLimit = std::max(hardLimit, 1u);
+	}
+}
+
+/**
+ * method run every so many states searched, stops the search once it passes
+ * its node limit or hard time limit and keeps a UCI front end posted on
+ * progress. The first iteration always finishes, so there is a move to play
+ */
+void Computer::poll() {
+	// time only counts once the opponent has moved
+	if (onOpponentTime()) { return; }
+	unsigned int ms = elapsed();
+	if (completed > 0) {
+		if (nodeLimit > 0 && evalCount >= nodeLimit) { stopped->store(true); }
+		if (hardLimit > 0 && ms >= hardLimit) { stopped->store(true); }
+	}
+	std::chrono::steady_clock::time_point now;
+	now = std::chrono::steady_clock::now();
+	// a copy, as binding the constant to a reference would need a definition
+	unsigned int interval = INFO_INTERVAL;
+	if (uci && now - infoTime >= std::chrono::milliseconds(interval)) {
+		infoTime = now;
+		std::ostringstream out;
+		out << "info nodes " << evalCount << " time " << ms;
+		out << " nps " << (evalCount * 1000ULL) / std::max(ms, 1u) << "\n";
+		// one write per line, so lines from other threads do not interleave
+		std::cout << out.str() << std::flush;
+	}
+}
+
+/**
+ * method to find the time since the search began
+ * @return - the milliseconds elapsed
+ */
+unsigned int Computer::elapsed() {
+	std::chrono::steady_clock::duration t;
+	t = std::chrono::steady_clock::now() - startTime;
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t).count();
+}
+
 /**
  * method to let console know number of game states evaluated as well as the
  * score the AI gave the board
  * @param s - the score
- * @param e - how many equivalent moves found
  */
-inline void Computer::printData(int s, unsigned int e) {
+inline void Computer::printData(int s) {
 	std::cout << "\n" << evalCount << " game state(s) evaluated; ";
 	std::cout << pruneCount << " pruned.\n";
-	if (e > 1) {
-		std::cout << "Found " << e << " equivalent moves; ";
-		std::cout << "chose one stochastically.\n";
-	}
+	std::cout << "Principal variation:";
+	for (unsigned int i = 0; i < pv.size(); i++) { std::cout << " " << pv[i]; }
+	std::cout << "\n";
 	std::cout << (getColor() ? "White" : "Black");
 	std::cout << " chose a move with score " << s << ".\n";
-	evalCount = 0; pruneCount = 0;
+	if (clockTime > 0) {
+		std::cout << (clockTime / 1000.0) << "s left on the clock.\n";
+	}
+}
+
+/**
+ * method to report a finished iteration to a UCI front end, scores are given
+ * in hundredths of a pawn, or as the moves to mate
+ * @param d - the depth searched
+ * @param s - the score
+ */
+void Computer::printInfo(unsigned int d, int s) {
+	unsigned int ms = elapsed();
+	std::ostringstream out;
+	out << "info depth " << d << " score ";
+	if (s >= MATE_BOUND) {
+		out << "mate " << (GameParams::CHECKMATE - s + 1) / 2;
+	} else if (s <= -MATE_BOUND) {
+		out << "mate -" << (GameParams::CHECKMATE + s) / 2;
+	} else {
+		out << "cp " << (s * 100) / (GameParams::C1 * (int)GameParams::P_VAL);
+	}
+	out << " nodes " << evalCount << " time " << ms;
+	out << " nps " << (evalCount * 1000ULL) / std::max(ms, 1u) << " pv";
+	// each move is written as it is made in the position it is made in
+	Board board(*root);
+	for (unsigned int i = 0; i < pv.size(); i++) {
+		out << " " << board.toUci(pv[i]);
+		board.movePiece(pv[i]);
+	}
+	out << "\n";
+	std::cout << out.str() << std::flush;
+	infoTime = std::chrono::steady_clock::now();
 }
 
 // accessor methods
 unsigned int Computer::getDepth() { return depth; }
+unsigned int Computer::getThreads() { return threads; }
+std::vector<Move> Computer::getPrincipalVariation() { return pv; }
 
 // mutator methods
 void Computer::setDepth(unsigned int d) { depth = d; }
+void Computer::setThreads(unsigned int t) { threads = (t > 0) ? t : 1; }
+
+/**
+ * method to limit the next searches, a search stops at whichever limit it
+ * reaches first and plays the best move of its last full iteration
+ * @param d - the depth to search to, 0 for as deep as the AI searches
+ * @param n - the states to search, 0 for no limit
+ * @param ms - the milliseconds to search, 0 for no limit
+ */
+void Computer::setLimits(unsigned int d, unsigned int n, unsigned int ms) {
+	setDepth((d > 0 && d < MAX_PLY) ? d : MAX_PLY);
+	nodeLimit = n;
+	moveTime = ms;
+}
+
+/**
+ * method to put the AI on the clock, the time for each search is then shared
+ * out from what is left. Without a fixed time per move from setLimits, the AI
+ * takes the time it uses off the clock itself
+ * @param t - the milliseconds left, 0 for not on the clock
+ * @param inc - the milliseconds added after each move
+ * @param mtg - the moves to the next time control, 0 if unknown
+ */
+void Computer::setClock(unsigned int t, unsigned int inc, unsigned int mtg) {
+	clockTime = t;
+	increment = inc;
+	movesToGo = mtg;
+}
+
+/**
+ * method to report as a UCI engine, with info lines rather than prose
+ * @param u - whether to
+ */
+void Computer::setUci(bool u) { uci = u; }
+
+/**
+ * method to stop a search from another thread, or to clear a stop before one
+ * @param s - whether the search should stop
+ */
+void Computer::setStopped(bool s) { stopped->store(s); }
+
+/**
+ * method to have the AI search on the opponent's time, see startPondering
+ * @param p - whether to
+ */
+void Computer::setPonder(bool p) { ponder = p; }
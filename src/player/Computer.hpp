@@ -1,30 +1,115 @@
+#pragma once
 #include "Player.hpp"
+#include "TransTable.hpp"
+#include "MovePicker.hpp"
 #include <limits.h>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory> // for shared_ptr
 
 // Computer class declaration, derived class from base Player class
 
 class Computer : public Player {
 	private:
 		unsigned int depth; // depth for tree search
+		unsigned int threads; // number of search threads
 		unsigned int evalCount = 0; // number of states eval'd
 		unsigned int pruneCount = 0; // number of states pruned
-		std::vector<std::string> buffer; // move buffer
+		std::shared_ptr<TransTable> table; // transposition table
+		std::shared_ptr<std::atomic<bool> > stopped; // tells search to stop
+		Board* root = NULL; // the position searched
+		Move bestMove; // best move of the last full iteration
+		std::vector<Move> pv; // principal variation, expected line of play
+		bool uci = false; // whether to report as UCI info lines
+		unsigned int nodeLimit = 0; // states to stop after, 0 for no limit
+		unsigned int moveTime = 0; // ms per move, 0 for no limit
+		unsigned int clockTime = 0; // ms left on the clock, 0 if not on one
+		unsigned int increment = 0; // ms added to the clock each move
+		unsigned int movesToGo = 0; // moves to the time control, 0 if unknown
+		unsigned int softLimit = 0; // ms after which no iteration is begun
+		unsigned int hardLimit = 0; // ms after which the search is stopped
+		unsigned int completed = 0; // depth of the last full iteration
+		std::chrono::steady_clock::time_point startTime; // of the search
+		std::chrono::steady_clock::time_point infoTime; // of the last info
+		bool ponder = false; // whether to search on the opponent's time
+		std::shared_ptr<std::thread> ponderer; // the ponder search, if any
+		std::shared_ptr<std::atomic<bool> > pondering; // the opponent to move
+		bool ponderClock = false; // whether the clock waits on the opponent
+		Board ponderBoard; // the position after the reply expected
+		uint64_t ponderKey; // its key, to tell if the reply was played
+
+		/**
+		 * aspiration windows, from this depth the root is first searched in a
+		 * window this far either side of the previous iteration's score
+		 */
+		const static unsigned int ASPIRATION_DEPTH = 3;
+		const static int ASPIRATION_WINDOW = 16;
+
+		// limits are checked every so many states, and UCI info sent so often
+		const static unsigned int POLL_NODES = 1024;
+		const static unsigned int INFO_INTERVAL = 1000; // ms
+
+		// move ordering tables, see MovePicker for the order moves are tried
+		const static int HISTORY_MAX = 1 << 20; // history is halved past this
+		const static unsigned int MAX_PLY = 64; // plies with killer slots
+		const static unsigned int SQUARES = 64;
+		/**
+		 * scores beyond this are mates, their distance from the root
+		 * subtracted. Helpers search a ply past the depth cap of MAX_PLY, so
+		 * mates are left twice that many plies of room
+		 */
+		const static int MATE_BOUND = GameParams::CHECKMATE - 2 * (int)MAX_PLY;
+		Move killers[MAX_PLY][2]; // quiet moves which last caused a cutoff
+		int history[2][SQUARES][SQUARES]; // quiet cutoffs by color, orig, dest
 
 		// private member methods
-		Move negamaxHandler(int, int);
-		int negamax(Board*, unsigned int, int, int, bool);
+		bool findRootMoves(MoveList&);
+		void beginSearch();
+		void search(MoveList);
+		void startPondering(Move);
+		void stopPondering();
+		bool onOpponentTime();
+		int aspirationSearch(MoveList&, unsigned int, int);
+		int negamaxHandler(MoveList&, unsigned int, int, int);
+		void helperSearch(MoveList, unsigned int);
+		int negamax(Board*, unsigned int, unsigned int, int, int, bool, bool);
+		int toTable(int, unsigned int);
+		int fromTable(int, unsigned int);
+		int quiesce(Board*, int, int, bool);
+		void storeCutoff(const Move&, unsigned int, unsigned int, bool);
+		void ageOrdering();
+		void ageHistory();
+		void findPrincipalVariation(unsigned int);
 		int evalBoard(Board*);
-		void printData(int, unsigned int);
+		void allocateTime();
+		void poll();
+		unsigned int elapsed();
+		void printData(int);
+		void printInfo(unsigned int, int);
 
 		// accessor methods
 		unsigned int getDepth();
+		unsigned int getThreads();
 
 		// mutator methods
 		void setDepth(unsigned int);
+		void setThreads(unsigned int);
 	public:
-		Computer(bool, unsigned int);
+		Computer(bool, unsigned int, unsigned int, unsigned int);
 
 		// public member methods
 		Move promptMove();
+		void endGame();
+
+		// public accessor methods
+		std::vector<Move> getPrincipalVariation();
+
+		// public mutator methods
+		void setLimits(unsigned int, unsigned int, unsigned int);
+		void setClock(unsigned int, unsigned int, unsigned int);
+		void setUci(bool);
+		void setStopped(bool);
+		void setPonder(bool);
 };
@@ -6,19 +6,18 @@
  * Human class constructor
  * @param c - the color of the player
  */
-Human::Human(bool c) {
+Human::Human(bool c) : quitting(false) {
 	setColor(c);
 }
 
 /**
  * method to prompt user for their move
- * @return - the move they've chosen
+ * @return - the move they've chosen, not to be made should they have quit
  */
 Move Human::promptMove() {
 	std::string s;
-	// get all available moves
-	std::vector<Move> moveList = getBoard()->getAllMoves(!getColor());
-	removeCheckedMoves(moveList);
+	// get all available moves, which never leave the player in check
+	const MoveList &moveList = getBoard()->getStatus(getColor()).moves;
 	while(true) { // continue prompting until valid
 		std::cout << "\n";
 		std::cout << "Enter a move in the form of 'a1b2' (from a1 to b2).\n";
@@ -28,7 +27,7 @@ Move Human::promptMove() {
 		// if command length is invalid
 		if (s.size() != 2 && s.size() != 4) { errorMessage(1); continue; }
 		// if quitting game
-		if (s == "quit") { quitGame(); }
+		if (s == "quit") { quitGame(); return Move(0, 0, 0, 0); }
 		// if invalid coordinates
 		if (!verifyInput(s)) { errorMessage(2); continue; }
 		// if no piece on origin tile
@@ -93,7 +92,7 @@ inline bool Human::verifyInput(std::string s) {
  * @param l - list of moves
  * @return - whether move is valid
  */
-inline bool Human::verifyMove(Move m, std::vector<Move> l) {
+inline bool Human::verifyMove(Move m, const MoveList &l) {
 	// verify the proposed move exists in the movelist
 	for (unsigned int i = 0; i < l.size(); i++) {
 		if (l[i] == m) { return true; }
@@ -116,7 +115,10 @@ inline void Human::errorMessage(unsigned int i) {
 	}
 }
 
-// method to handle game quitting
+// method to handle game quitting, the game ends rather than making the move
 inline void Human::quitGame() {
-	exit(0); // impossible to unwrap into main() unfortunately
+	quitting = true;
 }
+
+// accessor methods
+bool Human::hasQuit() { return quitting; }
@@ -8,13 +8,18 @@ class Human : public Player {
 		void errorMessage(unsigned int);
 		bool verifyInput(std::string);
 		bool verifyShow(std::string);
-		bool verifyMove(Move, std::vector<Move>);
+		bool verifyMove(Move, const MoveList&);
 		bool checkOwner(unsigned int, unsigned int);
 		bool checkPiece(unsigned int, unsigned int);
 		void quitGame();
+
+		bool quitting; // whether the player has quit the game
 	public:
 		Human(bool); // constructor
 
 		// public member methods
 		Move promptMove();
+
+		// public accessor methods
+		bool hasQuit();
 };
@@ -0,0 +1,162 @@
+#include "MovePicker.hpp"
+
+// MovePicker class definition
+
+/**
+ * MovePicker constructor
+ * @param b - the board the moves are made on
+ * @param c - the moving player
+ * @param h - whether the transposition table had a move
+ * @param m - the move the transposition table had
+ * @param k - the ply's two killer moves, NULL if none
+ * @param t - the moving player's history, indexed by origin and destination
+ */
+MovePicker::MovePicker(Board* b, bool c, bool h, Move m, const Move* k,
+						const int (*t)[64])
+	: board(b), color(c), quiescent(false), hashHit(h), hashMove(m),
+		killers(k), history(t), stage(HASH), index(0) {}
+
+/**
+ * MovePicker constructor for quiescence search, captures and promotions only
+ * @param b - the board the moves are made on
+ * @param c - the moving player
+ */
+MovePicker::MovePicker(Board* b, bool c)
+	: board(b), color(c), quiescent(true), hashHit(false), killers(NULL),
+		history(NULL), stage(HASH), index(0) {}
+
+/**
+ * method to hand out the next move
+ * @param m - set to the next move
+ * @return - whether there was a move left
+ */
+bool MovePicker::next(Move &m) {
+	while (stage != DONE) {
+		if (stage == HASH) {
+			nextStage();
+			// a stored move may come from a different position sharing a key
+			if (hashHit && board->isLegal(color, hashMove)) {
+				m = hashMove; return true;
+			}
+		} else if (stage == CAPTURES) {
+			while (pickBest(m)) {
+				if (hashHit && m == hashMove) { continue; }
+				if (isLosing(m)) { badCaptures.push_back(m); continue; }
+				return true;
+			}
+			nextStage();
+		} else if (stage == KILLERS) {
+			while (killers && index < 2) {
+				m = killers[index++];
+				if (hashHit && m == hashMove) { continue; }
+				// a killer from another position must be a quiet move here
+				unsigned int s = Bitboards::index(m.getDestC(), m.getDestR());
+				if (board->getType(!color, s) != Piece::TYPES) { continue; }
+				if (board->isLegal(color, m)) { return true; }
+			}
+			nextStage();
+		} else if (stage == QUIETS) {
+			while (pickBest(m)) {
+				if (!isHashOrKiller(m)) { return true; }
+			}
+			nextStage();
+		} else if (stage == BAD_CAPTURES) {
+			if (index < badCaptures.size()) {
+				m = badCaptures[index++]; return true;
+			}
+			nextStage();
+		} else if (stage == PROMOTIONS) {
+			if (index < moves.size()) { m = moves[index++]; return true; }
+			nextStage();
+		}
+	}
+	return false;
+}
+
+// method to move on to the next stage, generating and scoring its moves
+void MovePicker::nextStage() {
+	if (!quiescent) {
+		stage++;
+	} else if (stage == HASH) {
+		stage = CAPTURES;
+	} else {
+		// quiescence skips the killers, quiet moves and losing captures
+		stage = (stage == CAPTURES) ? PROMOTIONS : DONE;
+	}
+	index = 0;
+	if (stage == CAPTURES) {
+		moves.clear();
+		board->getCaptures(!color, moves);
+		for (unsigned int i = 0; i < moves.size(); i++) {
+			const Move &m = moves[i];
+			unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+			unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+			// most valuable victim first, then least valuable attacker
+			int victim = GameParams::VALUES[board->getType(!color, dest)];
+			int attacker = GameParams::VALUES[board->getType(color, orig)];
+			scores[i] = (victim * (GameParams::K_VAL + 1)) - attacker;
+		}
+	} else if (stage == QUIETS) {
+		moves.clear();
+		board->getQuiets(!color, moves);
+		for (unsigned int i = 0; i < moves.size(); i++) {
+			const Move &m = moves[i];
+			unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+			unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+			scores[i] = history[orig][dest];
+		}
+	} else if (stage == PROMOTIONS) {
+		moves.clear();
+		board->getPromotions(!color, moves);
+	}
+}
+
+/**
+ * method to hand out the best scored move left in the stage, moves of equal
+ * score are handed out in the order they were generated
+ * @param m - set to the move
+ * @return - whether there was a move left
+ */
+bool MovePicker::pickBest(Move &m) {
+	if (index >= moves.size()) { return false; }
+	unsigned int best = index;
+	for (unsigned int i = index + 1; i < moves.size(); i++) {
+		if (scores[i] > scores[best]) { best = i; }
+	}
+	// shift the skipped moves up rather than swap, keeping their order
+	m = moves[best];
+	int score = scores[best];
+	for (unsigned int i = best; i > index; i--) {
+		moves[i] = moves[i-1]; scores[i] = scores[i-1];
+	}
+	moves[index] = m; scores[index] = score;
+	index++;
+	return true;
+}
+
+/**
+ * method to determine if a move was handed out in an earlier stage
+ * @param m - the move
+ * @return - whether it is the hash move or a killer
+ */
+bool MovePicker::isHashOrKiller(const Move &m) {
+	if (hashHit && m == hashMove) { return true; }
+	return killers && (m == killers[0] || m == killers[1]);
+}
+
+/**
+ * method to determine if a capture gives up more than it takes once the
+ * exchange on the square is played out
+ * @param m - the capture
+ * @return - whether the capture loses material
+ */
+bool MovePicker::isLosing(const Move &m) {
+	unsigned int orig = Bitboards::index(m.getOrigC(), m.getOrigR());
+	unsigned int dest = Bitboards::index(m.getDestC(), m.getDestR());
+	// taking a piece worth as much or more cannot lose, whatever follows
+	int victim = GameParams::VALUES[board->getType(!color, dest)];
+	if (victim >= GameParams::VALUES[board->getType(color, orig)]) {
+		return false;
+	}
+	return board->see(m) < 0;
+}
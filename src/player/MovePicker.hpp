@@ -0,0 +1,53 @@
+#pragma once
+#include "../board/Board.hpp"
+
+/**
+ * MovePicker class declaration, hands out the moves of a search node one at a
+ * time in stages, generating each stage only once the one before has run out:
+ *  1. the transposition table's move
+ *  2. captures which do not lose material, by most valuable victim then
+ *     least valuable attacker
+ *  3. the two killer moves of the ply
+ *  4. the quiet moves, by history
+ *  5. the captures which lose material once the exchange on the square is
+ *     played out (see Board::see), put off from stage 2
+ * Most nodes cut off on one of the first few moves, and those never pay for
+ * generating the quiet moves. Within a stage the best move is picked each time
+ * rather than sorting the whole stage up front. For quiescence search it hands
+ * out only the captures of stage 2 followed by the promotions which do not
+ * capture, the losing captures are not worth searching there
+ */
+
+class MovePicker {
+	private:
+		// stages, in the order moves are handed out
+		const static unsigned int HASH = 0, CAPTURES = 1, KILLERS = 2;
+		const static unsigned int QUIETS = 3, BAD_CAPTURES = 4, DONE = 5;
+		const static unsigned int PROMOTIONS = 6; // quiescence only
+		const static unsigned int SQUARES = 64;
+
+		Board* board; // the position the moves are made in
+		bool color; // the moving player
+		bool quiescent; // whether only material changing moves are wanted
+		bool hashHit; // whether there is a hash move
+		Move hashMove; // the transposition table's move
+		const Move* killers; // the ply's two killers, NULL if none
+		const int (*history)[SQUARES]; // the moving player's history
+		unsigned int stage; // the stage being handed out
+		unsigned int index; // the next move within the stage
+		MoveList moves; // the moves of the current stage
+		int scores[MoveList::CAPACITY]; // their ordering scores
+		MoveList badCaptures; // losing captures, put off until last
+
+		// private member methods
+		void nextStage();
+		bool pickBest(Move&);
+		bool isHashOrKiller(const Move&);
+		bool isLosing(const Move&);
+	public:
+		MovePicker(Board*, bool, bool, Move, const Move*, const int (*)[64]);
+		MovePicker(Board*, bool);
+
+		// public member methods
+		bool next(Move&);
+};
@@ -2,29 +2,18 @@
 
 // Player class definition
 
+// virtual destructor
+Player::~Player() {}
+
 /**
- * method to remove moves which would put player in check
- * @param m - movelist to remove moves from
+ * method to tell the player the game is over, so that anything it still has
+ * running for the game is stopped before the players go away
  */
-void Player::removeCheckedMoves(std::vector<Move> &m) {
-	std::vector<int> indexes;
-	for (unsigned int i = 0; i < m.size(); i++) {
-		// make move on a copy and check if check
-		Board* copy = new Board(*getBoard());
-		copy->movePiece(m[i]);
-		if (copy->determineCheck(getColor())) {
-			indexes.insert(indexes.begin(), i);
-		}
-		delete copy;
-	}
-	for (unsigned int i = 0; i < indexes.size(); i++) {
-		m.erase(m.begin() + indexes[i]);
-	}
-	indexes.clear();
-}
+void Player::endGame() {}
 
 // accessor methods
 bool Player::getColor() { return color; }
+bool Player::hasQuit() { return false; }
 Board* Player::getBoard() { return gameboard; }
 
 // mutator methods
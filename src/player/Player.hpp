@@ -8,20 +8,21 @@ class Player {
 		Board* gameboard; // the board the player is playing
 		bool color; // color of the player
 	protected:
-		// protected member methods
-		void removeCheckedMoves(std::vector<Move>&);
-
 		// protected accessor methods
 		Board* getBoard();
 
 		// protected mutator methods
 		void setColor(bool);
 	public:
+		virtual ~Player(); // destructor
+
 		// member methods
 		virtual Move promptMove()=0;
+		virtual void endGame();
 
 		// public accessor methods
 		bool getColor();
+		virtual bool hasQuit();
 
 		// public mutator methods
 		void setBoard(Board*);
@@ -0,0 +1,149 @@
+#include "TransTable.hpp"
+#include <stdlib.h>
+#include <limits.h>
+
+/**
+ * TransTable class definition, entry data is packed into 64 bits as below
+ *  bits  0-11: best move origin and destination squares
+ *  bits 16-31: score
+ *  bits 32-39: depth searched
+ *  bits 40-41: bound type
+ *  bits 48-55: search generation it was stored in
+ *  bit     63: set on every written entry
+ */
+
+/**
+ * TransTable constructor
+ * @param mb - the table size in megabytes
+ */
+TransTable::TransTable(unsigned int mb) : memory(NULL), age(0) {
+	resize(mb);
+}
+
+// destructor
+TransTable::~TransTable() {
+	free(memory);
+}
+
+/**
+ * method to reallocate the table, this clears all entries
+ * @param mb - the table size in megabytes
+ */
+void TransTable::resize(unsigned int mb) {
+	free(memory);
+	// use the largest power of two bucket count which fits
+	size_t bytes = (size_t)((mb > 0) ? mb : 1) << 20;
+	count = 1;
+	while (count * 2 * sizeof(Bucket) <= bytes) { count *= 2; }
+	// over-allocate by one cache line to align the buckets
+	memory = (char*)malloc((count + 1) * sizeof(Bucket));
+	size_t offset = (size_t)memory % sizeof(Bucket);
+	offset = (offset == 0) ? 0 : sizeof(Bucket) - offset;
+	buckets = (Bucket*)(memory + offset);
+	clear();
+}
+
+// method to empty the table
+void TransTable::clear() {
+	for (size_t i = 0; i < count; i++) {
+		for (unsigned int j = 0; j < BUCKET_SIZE; j++) {
+			buckets[i].entries[j].check.store(0, std::memory_order_relaxed);
+			buckets[i].entries[j].data.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+/**
+ * method to start a new search generation, entries from earlier searches are
+ * still probed but are replaced first
+ */
+void TransTable::newSearch() {
+	age = (age + 1) & 0xFF;
+}
+
+/**
+ * method to look up a position
+ * @param k - the Zobrist key of the position
+ * @param d - set to the depth the stored score was searched to
+ * @param b - set to the bound type of the stored score
+ * @param s - set to the stored score
+ * @param m - set to the stored best move, origin equals destination if none
+ * @return - whether the position was found
+ */
+bool TransTable::probe(uint64_t k, unsigned int &d, unsigned int &b, int &s,
+						Move &m) {
+	Bucket &bucket = buckets[k & (count - 1)];
+	for (unsigned int i = 0; i < BUCKET_SIZE; i++) {
+		Entry &e = bucket.entries[i];
+		uint64_t check = e.check.load(std::memory_order_relaxed);
+		uint64_t data = e.data.load(std::memory_order_relaxed);
+		// a mismatch is another position, or a half-written entry
+		if ((check ^ data) != k || data == 0) { continue; }
+		unsigned int orig = data & 0x3F, dest = (data >> 6) & 0x3F;
+		m = Move(orig % 8, orig / 8, dest % 8, dest / 8);
+		s = (int16_t)((data >> 16) & 0xFFFF);
+		d = getDepth(data);
+		b = (data >> 40) & 0x3;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * method to store a search result, an entry for the same position is always
+ * overwritten, otherwise the entry from the oldest generation is replaced with
+ * the shallowest entry breaking ties
+ * @param k - the Zobrist key of the position
+ * @param d - the depth searched
+ * @param b - the bound type of the score
+ * @param s - the score
+ * @param m - the best move found
+ */
+void TransTable::store(uint64_t k, unsigned int d, unsigned int b, int s,
+						Move m) {
+	Bucket &bucket = buckets[k & (count - 1)];
+	Entry* victim = &bucket.entries[0];
+	int victimWorth = INT_MAX;
+	for (unsigned int i = 0; i < BUCKET_SIZE; i++) {
+		Entry &e = bucket.entries[i];
+		uint64_t check = e.check.load(std::memory_order_relaxed);
+		uint64_t data = e.data.load(std::memory_order_relaxed);
+		if ((check ^ data) == k || data == 0) { victim = &e; break; }
+		// each generation of staleness counts for more than any depth
+		int stale = (age - getAge(data)) & 0xFF;
+		int worth = (int)getDepth(data) - (stale * 256);
+		if (worth < victimWorth) { victim = &e; victimWorth = worth; }
+	}
+	uint64_t data = pack(d, b, s, m);
+	victim->check.store(k ^ data, std::memory_order_relaxed);
+	victim->data.store(data, std::memory_order_relaxed);
+}
+
+/**
+ * method to pack entry data into 64 bits
+ * @param d - the depth searched
+ * @param b - the bound type of the score
+ * @param s - the score
+ * @param m - the best move found
+ * @return - the packed data
+ */
+inline uint64_t TransTable::pack(unsigned int d, unsigned int b, int s,
+									Move m) {
+	uint64_t orig = (m.getOrigR() * 8) + m.getOrigC();
+	uint64_t dest = (m.getDestR() * 8) + m.getDestC();
+	uint64_t data = orig | (dest << 6);
+	data |= (uint64_t)(uint16_t)s << 16;
+	data |= (uint64_t)((d > 0xFF) ? 0xFF : d) << 32;
+	data |= (uint64_t)b << 40;
+	data |= (uint64_t)age << 48;
+	return data | (1ULL << 63);
+}
+
+// accessors into packed data
+inline unsigned int TransTable::getDepth(uint64_t data) {
+	return (data >> 32) & 0xFF;
+}
+
+inline unsigned int TransTable::getAge(uint64_t data) {
+	return (data >> 48) & 0xFF;
+}
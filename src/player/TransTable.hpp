@@ -0,0 +1,53 @@
+#pragma once
+#include "../game/Move.hpp"
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * TransTable class declaration, a fixed-size transposition table keyed by
+ * Zobrist key. Entries are packed four to a 64 byte bucket so that a probe
+ * touches a single cache line. Search threads share one table without locks:
+ * each entry stores its key XORed with its data, so an entry torn by two
+ * threads writing at once fails verification and is treated as a miss
+ */
+
+class TransTable {
+	private:
+		// an entry is the full key XOR the data, and the packed data
+		struct Entry {
+			std::atomic<uint64_t> check;
+			std::atomic<uint64_t> data;
+		};
+		const static unsigned int BUCKET_SIZE = 4; // entries per bucket
+		struct Bucket {
+			Entry entries[BUCKET_SIZE];
+		};
+
+		char* memory; // allocation the buckets are aligned within
+		Bucket* buckets; // cache line aligned buckets
+		size_t count; // number of buckets, a power of two
+		unsigned int age; // search generation, ages out old entries
+
+		// private member methods
+		uint64_t pack(unsigned int, unsigned int, int, Move);
+		unsigned int getDepth(uint64_t);
+		unsigned int getAge(uint64_t);
+
+		// disallow copies, the table is shared by pointer
+		TransTable(const TransTable&);
+		TransTable& operator=(const TransTable&);
+	public:
+		// bound types of stored scores
+		const static unsigned int EXACT = 0, LOWER = 1, UPPER = 2;
+
+		TransTable(unsigned int); // constructor
+		~TransTable(); // destructor
+
+		// public member methods
+		void resize(unsigned int);
+		void clear();
+		void newSearch();
+		bool probe(uint64_t, unsigned int&, unsigned int&, int&, Move&);
+		void store(uint64_t, unsigned int, unsigned int, int, Move);
+};
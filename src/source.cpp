@@ -1,13 +1,15 @@
 #include "game/Game.hpp"
 #include "player/Human.hpp"
 #include "player/Computer.hpp"
+#include "game/Perft.hpp"
+#include "game/Uci.hpp"
 
 const bool WHITE = true, BLACK = false;
 
 // remind user of proper compilation and execution
 inline void printHelp() {
 	std::cout << "\nCompile and execute the program as so:\n\n";
-	std::cout << " $ g++ source.cpp */*.cpp -o chess\n";
+	std::cout << " $ g++ source.cpp */*.cpp -o chess -pthread\n";
 	std::cout << " $ ./chess <args>\n\n";
 
 	std::cout << "You may use no arguments for a Human vs. Human game.\n\n";
@@ -20,18 +22,86 @@ inline void printHelp() {
 	std::cout << " <arg2> - Depth for Tree Search\n";
 	std::cout << "  - some integer value >0\n\n";
 
+	std::cout << "Or \"perft <depth>\" to count the legal move tree from the\n";
+	std::cout << "initial position to some depth >0 (for testing).\n\n";
+
+	std::cout << "Or \"uci\" to play through the Universal Chess Interface,\n";
+	std::cout << "for use with chess GUIs and other programs.\n\n";
+
+	std::cout << "Options may follow the arguments:\n";
+	std::cout << " --hash <MB> - transposition table size per AI player\n";
+	std::cout << "   (for perft, enables a subtree count table)\n";
+	std::cout << " --threads <N> - search threads per AI player\n";
+	std::cout << " --movetime <ms> - time per AI move, depth still a limit\n";
+	std::cout << " --clock <s> - AI players play on a clock of this time\n";
+	std::cout << " --inc <ms> - increment added to the clock each move\n\n";
+
 	std::cout << "When prompted, enter one of the below commands:\n";
 	std::cout << " - a move (in the form of a0b1, i.e. a0 to b1)\n";
 	std::cout << " - a single coordinate to see possible moves\n";
 	std::cout << " - \"quit\" to quit the current game\n\n";
 }
 
+/**
+ * method to create an AI player for a game
+ * @param c - the color of the player
+ * @param d - the depth for tree search
+ * @param h - the transposition table size in megabytes
+ * @param t - the number of search threads
+ * @param mt - the milliseconds per move, 0 for no limit
+ * @param clk - the milliseconds on its clock, 0 for no clock
+ * @param inc - the milliseconds added to its clock each move
+ * @return - the player
+ */
+inline Computer* newComputer(bool c, unsigned int d, unsigned int h,
+								unsigned int t, unsigned int mt,
+								unsigned int clk, unsigned int inc) {
+	Computer* ai = new Computer(c, d, h, t);
+	ai->setLimits(d, 0, mt);
+	ai->setClock(clk, inc, 0);
+	return ai;
+}
+
 // main program driver
 int main(int argc, char** argv) {
 	// create two empty players, init later
 	Player* white; Player* black;
 	// init game board
 	Board* gameboard = new Board();
+	// options come after the arguments, strip them off first
+	unsigned int hash = 0, threads = 1, moveTime = 0, clock = 0, inc = 0;
+	while (argc >= 3 && std::string(argv[argc-2]).substr(0, 2) == "--") {
+		std::string option(argv[argc-2]);
+		if (atoi(argv[argc-1]) < 1) { printHelp(); return 1; }
+		if (option == "--hash") {
+			hash = atoi(argv[argc-1]);
+		} else if (option == "--threads") {
+			threads = atoi(argv[argc-1]);
+		} else if (option == "--movetime") {
+			moveTime = atoi(argv[argc-1]);
+		} else if (option == "--clock") {
+			clock = atoi(argv[argc-1]) * 1000;
+		} else if (option == "--inc") {
+			inc = atoi(argv[argc-1]);
+		} else {
+			printHelp(); return 1;
+		}
+		argc -= 2;
+	}
+	// perft mode counts the move tree instead of playing
+	if (argc == 3 && std::string(argv[1]) == "perft") {
+		if (atoi(argv[2]) < 1) { printHelp(); return 1; }
+		Perft p(gameboard, WHITE, atoi(argv[2]), threads, hash);
+		p.run();
+		return 0;
+	}
+	if (hash == 0) { hash = GameParams::HASH_SIZE; } // AI default
+	// uci mode takes commands on standard input instead of playing a game
+	if (argc == 2 && std::string(argv[1]) == "uci") {
+		Uci u(hash, threads);
+		u.run();
+		return 0;
+	}
 	if (argc != 1 && argc != 3) { // if invalid num args
 		printHelp(); return 1;
 	} else { // no argument or two arguments
@@ -42,18 +112,27 @@ int main(int argc, char** argv) {
 			// if invalid depth
 			if (atoi(argv[2]) < 1) { printHelp(); return 1; }
 			unsigned int depth = atoi(argv[2]); // depth valid, init
+			Computer* ai;
 			switch(atoi(argv[1])) { // determine type of game
-				case 1: // human vs ai
+				case 1: // human vs ai, which searches on the human's time
 					white = new Human(WHITE);
-					black = new Computer(BLACK, depth);
+					ai = newComputer(BLACK, depth, hash, threads, moveTime,
+										clock, inc);
+					ai->setPonder(GameParams::PONDER);
+					black = ai;
 					break;
 				case 2: // ai vs human
-					white = new Computer(WHITE, depth);
+					ai = newComputer(WHITE, depth, hash, threads, moveTime,
+										clock, inc);
+					ai->setPonder(GameParams::PONDER);
+					white = ai;
 					black = new Human(BLACK);
 					break;
 				case 3: // ai vs ai
-					white = new Computer(WHITE, depth);
-					black = new Computer(BLACK, depth);
+					white = newComputer(WHITE, depth, hash, threads, moveTime,
+										clock, inc);
+					black = newComputer(BLACK, depth, hash, threads, moveTime,
+										clock, inc);
 					break;
 				default: printHelp(); return 1;
 			}
@@ -61,5 +140,7 @@ int main(int argc, char** argv) {
 	}
 	Game g(gameboard, white, black); // init game
 	g.play(); // play the game
+	// the players have stopped everything they had running by now
+	delete white; delete black; delete gameboard;
 	return 0;
 }